@@ -172,6 +172,8 @@ inline constexpr byte keypad_function                  = terminalpp::detail::asc
     inline constexpr byte keypad_f10                   = 21;
     inline constexpr byte keypad_f11                   = 23; // Skip 22.
     inline constexpr byte keypad_f12                   = 24;
+    inline constexpr byte paste_begin                  = 200;
+    inline constexpr byte paste_end                    = 201;
 
 // The following modifiers can apply to all keypad/function key controls.
     inline constexpr byte modifier_shift               = 2;
@@ -49,6 +49,30 @@ inline constexpr byte all_motion_mouse_tracking[] =
                                     terminalpp::detail::ascii::zero,
                                     terminalpp::detail::ascii::three };
 
+// Set = report mouse events using SGR encoding.  Reset = use the normal
+// encoding.
+inline constexpr byte sgr_mouse_encoding[] =
+                                  { terminalpp::detail::ascii::one,
+                                    terminalpp::detail::ascii::zero,
+                                    terminalpp::detail::ascii::zero,
+                                    terminalpp::detail::ascii::six };
+
+// Set = report mouse events using SGR encoding, with positions in pixels.
+// Reset = use the normal encoding.
+inline constexpr byte sgr_pixel_mouse_encoding[] =
+                                  { terminalpp::detail::ascii::one,
+                                    terminalpp::detail::ascii::zero,
+                                    terminalpp::detail::ascii::one,
+                                    terminalpp::detail::ascii::six };
+
+// Set = surround pasted text with markers.  Reset = pass pasted text through
+// as it is.
+inline constexpr byte bracketed_paste[] =
+                                  { terminalpp::detail::ascii::two,
+                                    terminalpp::detail::ascii::zero,
+                                    terminalpp::detail::ascii::zero,
+                                    terminalpp::detail::ascii::four };
+
 inline constexpr byte use_alternate_screen_buffer[] =
                                   { terminalpp::detail::ascii::four,
                                     terminalpp::detail::ascii::seven };
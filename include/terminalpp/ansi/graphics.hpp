@@ -41,6 +41,12 @@ inline constexpr byte colour_magenta = 5;
 inline constexpr byte colour_cyan    = 6;
 inline constexpr byte colour_white   = 7;
 inline constexpr byte colour_default = 9;
+
+// Extended colour constants
+inline constexpr byte extended_foreground_colour = 38;
+inline constexpr byte extended_background_colour = 48;
+inline constexpr byte extended_colour_indexed    = 5;
+inline constexpr byte extended_colour_rgb        = 2;
 // clang-format on
 
 // "High" colour constants.
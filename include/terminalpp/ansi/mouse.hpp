@@ -19,4 +19,19 @@ inline constexpr byte scrollwheel_down = 65;
 // buttons and co-ordinate values.
 inline constexpr byte mouse_value_offset = terminalpp::detail::ascii::space;
 
+// In SGR mouse encoding, events are transmitted as "CSI < b ; x ; y M" for
+// presses and motion, and with a final 'm' for releases.  The values are
+// decimal parameters, so no offset is applied, and the button value is a
+// combination of the following fields.
+inline constexpr byte sgr_introducer = terminalpp::detail::ascii::less_than;
+inline constexpr byte sgr_press = terminalpp::detail::ascii::uppercase_m;
+inline constexpr byte sgr_release = terminalpp::detail::ascii::lowercase_m;
+
+inline constexpr byte button_mask = 0x03;
+inline constexpr byte shift_mask = 0x04;
+inline constexpr byte meta_mask = 0x08;
+inline constexpr byte ctrl_mask = 0x10;
+inline constexpr byte motion_mask = 0x20;
+inline constexpr byte wheel_mask = 0x40;
+
 }  // namespace terminalpp::ansi::mouse
@@ -12,4 +12,7 @@ namespace terminalpp::ansi {
 // Parameter Separator
 inline constexpr byte ps = terminalpp::detail::ascii::semi_colon;
 
+// Sub-Parameter Separator
+inline constexpr byte sub_ps = terminalpp::detail::ascii::colon;
+
 }  // namespace terminalpp::ansi
@@ -0,0 +1,306 @@
+#pragma once
+
+#include "terminalpp/core.hpp"
+
+#include <concepts>  // IWYU pragma: keep
+#include <functional>
+#include <memory>
+#include <span>
+#include <type_traits>
+
+namespace terminalpp {
+
+namespace detail {
+
+//* =========================================================================
+/// \brief Writes the fragments to the channel, in order.  If the channel
+/// does not support gathering writes, then any fragments are concatenated
+/// into the gathered buffer and written as one.
+//* =========================================================================
+template <typename Channel>
+void write_fragments(
+    Channel &channel,
+    std::span<bytes const> fragments,
+    byte_storage &gathered)
+{
+    if constexpr (requires { channel.write(fragments); })
+    {
+        channel.write(fragments);
+    }
+    else if (fragments.size() == 1)
+    {
+        channel.write(fragments.front());
+    }
+    else
+    {
+        gathered.clear();
+
+        for (auto const fragment : fragments)
+        {
+            gathered.append(fragment.begin(), fragment.end());
+        }
+
+        channel.write(bytes{gathered});
+    }
+}
+
+//* =========================================================================
+/// \brief Returns whether the channel is under backpressure.  Channels that
+/// do not report backpressure are never under it.
+//* =========================================================================
+template <typename Channel>
+[[nodiscard]] bool is_backpressured(Channel const &channel)
+{
+    if constexpr (requires { channel.is_backpressured(); })
+    {
+        return channel.is_backpressured();
+    }
+    else
+    {
+        return false;
+    }
+}
+
+//* =========================================================================
+/// \brief Returns whether the channel supports gathering writes; that is,
+/// whether it can send a sequence of fragments without first concatenating
+/// them.  A channel may report this with a supports_gathering() member
+/// function.  Otherwise, it is taken to support them if it has a
+/// write(std::span<bytes const>) member function.
+//* =========================================================================
+template <typename Channel>
+[[nodiscard]] bool supports_gathering(Channel const &channel)
+{
+    if constexpr (requires { channel.supports_gathering(); })
+    {
+        return channel.supports_gathering();
+    }
+    else
+    {
+        return requires(Channel &ch, std::span<bytes const> fragments) {
+            ch.write(fragments);
+        };
+    }
+}
+
+}  // namespace detail
+
+//* =========================================================================
+/// \brief A type-erased reference to a channel.
+///
+/// \par Usage
+/// A channel is any class with the following member functions:
+/// \code
+/// void async_read(std::function<void(terminalpp::bytes)> const &);
+/// void write(terminalpp::bytes);
+/// bool is_alive() const;
+/// void close();
+/// \endcode
+/// It may optionally also have the following:
+/// \code
+/// void write(std::span<terminalpp::bytes const>);
+/// bool is_backpressured() const;
+/// bool supports_gathering() const;
+/// \endcode
+/// An any_channel refers to any such channel, which must outlive it, so
+/// that a terminal can be used with channels of types that are not known
+/// at compile time.  This is the channel of terminalpp::terminal.
+//* =========================================================================
+class any_channel
+{
+public:
+    //* =====================================================================
+    /// \brief Constructor
+    //* =====================================================================
+    template <typename Channel>
+        requires(!std::same_as<std::remove_cv_t<Channel>, any_channel>)
+    explicit any_channel(Channel &channel)  // NOLINT
+      : channel_{std::make_unique<channel_model<Channel>>(channel)}
+    {
+    }
+
+    //* =====================================================================
+    /// \brief Asynchronously read from the channel and call the function
+    /// back when it's available.
+    //* =====================================================================
+    void async_read(std::function<void(bytes)> const &callback)
+    {
+        channel_->async_read(callback);
+    }
+
+    //* =====================================================================
+    /// \brief Write the given data to the channel.
+    //* =====================================================================
+    void write(bytes data)
+    {
+        channel_->write(data);
+    }
+
+    //* =====================================================================
+    /// \brief Write the given fragments to the channel, in order.
+    //* =====================================================================
+    void write(std::span<bytes const> fragments)
+    {
+        channel_->write(fragments);
+    }
+
+    //* =====================================================================
+    /// \brief Returns whether the channel is alive.
+    //* =====================================================================
+    [[nodiscard]] bool is_alive() const
+    {
+        return channel_->is_alive();
+    }
+
+    //* =====================================================================
+    /// \brief Closes the channel.
+    //* =====================================================================
+    void close()
+    {
+        channel_->close();
+    }
+
+    //* =====================================================================
+    /// \brief Returns whether the channel is under backpressure.
+    //* =====================================================================
+    [[nodiscard]] bool is_backpressured() const
+    {
+        return channel_->is_backpressured();
+    }
+
+    //* =====================================================================
+    /// \brief Returns whether the underlying channel supports gathering
+    /// writes.  Fragments written to a channel that does not are
+    /// concatenated before being sent.
+    //* =====================================================================
+    [[nodiscard]] bool supports_gathering() const
+    {
+        return channel_->supports_gathering();
+    }
+
+private:
+    //* =====================================================================
+    /// \brief An interface for a channel model.
+    //* =====================================================================
+    struct channel_concept
+    {
+        //* =================================================================
+        /// \brief Destructor
+        //* =================================================================
+        virtual ~channel_concept() = default;
+
+        //* =================================================================
+        /// \brief Asynchronously read from the channel and call the function
+        /// back when it's available.
+        //* =================================================================
+        virtual void async_read(std::function<void(bytes)> const &) = 0;
+
+        //* =================================================================
+        /// \brief Write the given data to the channel.
+        //* =================================================================
+        virtual void write(bytes data) = 0;
+
+        //* =================================================================
+        /// \brief Write the given fragments to the channel, in order.
+        //* =================================================================
+        virtual void write(std::span<bytes const> fragments) = 0;
+
+        //* =================================================================
+        /// \brief Returns whether the channel is alive.
+        //* =================================================================
+        [[nodiscard]] virtual bool is_alive() const = 0;
+
+        //* =================================================================
+        /// \brief Closes the channel.
+        //* =================================================================
+        virtual void close() = 0;
+
+        //* =================================================================
+        /// \brief Returns whether the channel is under backpressure.
+        //* =================================================================
+        [[nodiscard]] virtual bool is_backpressured() const = 0;
+
+        //* =================================================================
+        /// \brief Returns whether the channel supports gathering writes.
+        //* =================================================================
+        [[nodiscard]] virtual bool supports_gathering() const = 0;
+    };
+
+    //* =====================================================================
+    /// \brief An implementation of the channel model.
+    //* =====================================================================
+    template <typename Channel>
+    struct channel_model final : channel_concept
+    {
+        //* =================================================================
+        /// \brief Constructor
+        //* =================================================================
+        explicit channel_model(Channel &channel) : channel_(channel)
+        {
+        }
+
+        //* =================================================================
+        /// \brief Asynchronously read from the channel and call the function
+        /// back when it's available.
+        //* =================================================================
+        void async_read(std::function<void(bytes)> const &callback) override
+        {
+            channel_.async_read(callback);
+        }
+
+        //* =================================================================
+        /// \brief Write the given data to the channel.
+        //* =================================================================
+        void write(bytes data) override
+        {
+            channel_.write(data);
+        }
+
+        //* =================================================================
+        /// \brief Write the given fragments to the channel, in order.
+        //* =================================================================
+        void write(std::span<bytes const> fragments) override
+        {
+            detail::write_fragments(channel_, fragments, gathered_);
+        }
+
+        //* =================================================================
+        /// \brief Returns whether the channel is alive.
+        //* =================================================================
+        [[nodiscard]] bool is_alive() const override
+        {
+            return channel_.is_alive();
+        }
+
+        //* =================================================================
+        /// \brief Closes the channel.
+        //* =================================================================
+        void close() override
+        {
+            channel_.close();
+        }
+
+        //* =================================================================
+        /// \brief Returns whether the channel is under backpressure.
+        //* =================================================================
+        [[nodiscard]] bool is_backpressured() const override
+        {
+            return detail::is_backpressured(channel_);
+        }
+
+        //* =================================================================
+        /// \brief Returns whether the channel supports gathering writes.
+        //* =================================================================
+        [[nodiscard]] bool supports_gathering() const override
+        {
+            return detail::supports_gathering(channel_);
+        }
+
+        Channel &channel_;
+        byte_storage gathered_;
+    };
+
+    std::unique_ptr<channel_concept> channel_;
+};
+
+}  // namespace terminalpp
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "terminalpp/attribute.hpp"
+#include "terminalpp/core.hpp"
+
+#include <concepts>  // IWYU pragma: keep
+#include <vector>
+#include <cstddef>
+
+namespace terminalpp {
+
+//* =========================================================================
+/// \brief A cache of the encoded ANSI sequences that change the current
+/// attribute from one value to another.
+///
+/// \par Usage
+/// Applications often switch between a small number of attributes (for
+/// example, alternating row colours), and so recomputing the SGR sequence
+/// for each transition is wasted effort.  A cache can be given to a
+/// terminal (or shared between terminals with the same behaviour) with
+/// terminal::set_attribute_transition_cache, after which each transition
+/// is encoded only once.
+/// \par
+/// The cache is direct-mapped: each transition has exactly one slot,
+/// selected by its hash, and a new transition replaces whatever occupied
+/// its slot.  This bounds both its size and the cost of a lookup.
+//* =========================================================================
+class TERMINALPP_EXPORT attribute_transition_cache
+{
+public:
+    static constexpr std::size_t default_capacity = 256;
+
+    //* =====================================================================
+    /// \brief Constructor
+    /// \param capacity the number of transitions that may be held in the
+    /// cache.  A capacity of zero is treated as one.
+    //* =====================================================================
+    explicit attribute_transition_cache(
+        std::size_t capacity = default_capacity);
+
+    //* =====================================================================
+    /// \brief Returns the encoded sequence for the transition from source to
+    /// dest.
+    ///
+    /// If the transition is not cached, then encode is called with an
+    /// empty byte_storage into which it must write the sequence, which is
+    /// then retained for subsequent calls.  The returned bytes are valid
+    /// until the next call to this function.
+    //* =====================================================================
+    template <std::invocable<byte_storage &> Encoder>
+    [[nodiscard]] bytes get(
+        attribute const &source, attribute const &dest, Encoder &&encode)
+    {
+        auto &entry = slot_for(source, dest);
+
+        if (entry.occupied_ && entry.source_ == source && entry.dest_ == dest)
+        {
+            ++hits_;
+        }
+        else
+        {
+            ++misses_;
+            entry.source_ = source;
+            entry.dest_ = dest;
+            entry.encoding_.clear();
+            encode(entry.encoding_);
+            entry.occupied_ = true;
+        }
+
+        return entry.encoding_;
+    }
+
+    //* =====================================================================
+    /// \brief Returns the number of transitions that may be cached.
+    //* =====================================================================
+    [[nodiscard]] std::size_t capacity() const;
+
+    //* =====================================================================
+    /// \brief Returns the number of lookups that were found in the cache.
+    //* =====================================================================
+    [[nodiscard]] std::size_t hits() const;
+
+    //* =====================================================================
+    /// \brief Returns the number of lookups that had to be encoded.
+    //* =====================================================================
+    [[nodiscard]] std::size_t misses() const;
+
+    //* =====================================================================
+    /// \brief Removes all cached transitions and resets the counters.
+    //* =====================================================================
+    void clear();
+
+private:
+    struct slot
+    {
+        attribute source_;
+        attribute dest_;
+        byte_storage encoding_;
+        bool occupied_ = false;
+    };
+
+    //* =====================================================================
+    /// \brief Returns the slot in which the transition would be cached.
+    //* =====================================================================
+    [[nodiscard]] slot &slot_for(
+        attribute const &source, attribute const &dest);
+
+    std::vector<slot> slots_;
+    std::size_t hits_{0};
+    std::size_t misses_{0};
+};
+
+}  // namespace terminalpp
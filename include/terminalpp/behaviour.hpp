@@ -42,6 +42,16 @@ struct TERMINALPP_EXPORT behaviour
     // True if the terminal supports all mouse motion tracking.
     bool supports_all_mouse_motion_tracking : 1 {false};
 
+    // True if the terminal can report mouse events with SGR encoding.
+    bool supports_sgr_mouse_encoding : 1 {false};
+
+    // True if the terminal can report mouse events with SGR encoding and
+    // positions in pixels.
+    bool supports_sgr_pixel_mouse_encoding : 1 {false};
+
+    // True if the terminal supports bracketed paste mode.
+    bool supports_bracketed_paste : 1 {false};
+
     // True if the window title can be set with the BEL terminator.
     bool supports_window_title_bel : 1 {false};
 
@@ -2,7 +2,10 @@
 
 #include "terminalpp/element.hpp"
 #include "terminalpp/extent.hpp"
+#include "terminalpp/rectangle.hpp"
+#include "terminalpp/string.hpp"
 
+#include <span>
 #include <vector>
 
 namespace terminalpp {
@@ -13,7 +16,19 @@ namespace terminalpp {
 /// \par Usage
 /// The grid is formed from a contiguous block of memory.  Position [0,0]
 /// represents the top left of the grid, and it proceeds in a left-to-right
-/// manner first, then top-to-bottom.
+/// manner first, then top-to-bottom.  Because of this, whole rows are
+/// also available as contiguous spans, which is the most efficient way to
+/// write to large areas of the canvas.
+///
+/// \par Dirty Regions
+/// A canvas can optionally track which of its elements have been modified,
+/// so that a screen drawing it need only compare those parts against the
+/// previous frame.  Each row records the span of columns that have been
+/// modified since mark_clean() was last called.  Elements are considered
+/// modified when accessed through a non-const column_proxy, when a region
+/// is passed to mark_dirty() or written by one of the row operations, and
+/// (because writes through them cannot be observed) when the non-const
+/// begin(), end() or row() are called.
 //* =========================================================================
 class TERMINALPP_EXPORT canvas
 {
@@ -22,6 +37,15 @@ public:
     using iterator = element *;
     using const_iterator = element const *;
 
+    //* =====================================================================
+    /// \brief A half-open range of columns within a row.
+    //* =====================================================================
+    struct column_range
+    {
+        size_type begin_;
+        size_type end_;
+    };
+
     //* =====================================================================
     /// \brief A proxy into a column of elements on the canvas
     //* =====================================================================
@@ -38,6 +62,7 @@ public:
         // ==================================================================
         // OPERATOR[]
         // ==================================================================
+        // Accessing an element in this way marks it as dirty.
         [[nodiscard]] element &operator[](size_type row);
 
     private:
@@ -114,6 +139,63 @@ public:
     //* =====================================================================
     [[nodiscard]] const_column_proxy operator[](coordinate_type) const;
 
+    //* =====================================================================
+    /// \brief Returns the elements of the given row.  The whole row is
+    /// marked as dirty.
+    //* =====================================================================
+    [[nodiscard]] std::span<element> row(coordinate_type row);
+
+    //* =====================================================================
+    /// \brief Returns the elements of the given row.
+    //* =====================================================================
+    [[nodiscard]] std::span<element const> row(coordinate_type row) const;
+
+    //* =====================================================================
+    /// \brief Sets every element of the given row to elem.
+    //* =====================================================================
+    void fill_row(coordinate_type row, element const &elem);
+
+    //* =====================================================================
+    /// \brief Copies the elements of the source row over those of the
+    /// destination row.
+    //* =====================================================================
+    void copy_row(coordinate_type source_row, coordinate_type dest_row);
+
+    //* =====================================================================
+    /// \brief Copies the text into the row of the canvas given by origin,
+    /// starting at its column.  Any text that would lie beyond the left or
+    /// right edges of the canvas is clipped.
+    //* =====================================================================
+    void blit(point const &origin, string const &text);
+
+    //* =====================================================================
+    /// \brief Enables or disables the tracking of dirty regions.
+    ///
+    /// Tracking is disabled by default, in which case every element is
+    /// always considered dirty.  When tracking is enabled, the whole canvas
+    /// is initially dirty.
+    //* =====================================================================
+    void set_dirty_tracking(bool enabled);
+
+    //* =====================================================================
+    /// \brief Marks all elements within the region as dirty.  Any part of
+    /// the region that lies outside the canvas is ignored.
+    //* =====================================================================
+    void mark_dirty(rectangle const &region);
+
+    //* =====================================================================
+    /// \brief Marks all elements as clean.  This is typically called after
+    /// the canvas has been drawn.
+    //* =====================================================================
+    void mark_clean();
+
+    //* =====================================================================
+    /// \brief Returns the range of columns in the given row that contains
+    /// all of the dirty elements in that row.  This is empty if the row is
+    /// clean, and is the whole row if dirty regions are not being tracked.
+    //* =====================================================================
+    [[nodiscard]] column_range dirty_columns(coordinate_type row) const;
+
 private:
     //* =====================================================================
     /// \brief Get the value of an element.
@@ -127,8 +209,24 @@ private:
     [[nodiscard]] element const &get_element(
         coordinate_type column, coordinate_type row) const;
 
+    //* =====================================================================
+    /// \brief Returns the elements of the given row without marking them as
+    /// dirty.
+    //* =====================================================================
+    [[nodiscard]] std::span<element> row_elements(coordinate_type row);
+
+    //* =====================================================================
+    /// \brief Marks an individual element as dirty.
+    //* =====================================================================
+    void mark_element_dirty(coordinate_type column, coordinate_type row);
+
     std::vector<element> grid_;
     extent size_;
+
+    // If dirty regions are tracked, then this holds the dirty columns of
+    // each row.  Otherwise, it is empty.
+    std::vector<column_range> dirty_rows_;
+    bool dirty_tracking_{false};
 };
 
 }  // namespace terminalpp
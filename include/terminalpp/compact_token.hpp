@@ -0,0 +1,144 @@
+#pragma once
+
+#include "terminalpp/token.hpp"
+
+#include <compare>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <variant>
+#include <vector>
+#include <cstdint>
+
+namespace terminalpp {
+
+//* =========================================================================
+/// \brief The compact form of a virtual key.
+///
+/// Rather than holding the input sequence that generated the key, it holds
+/// either the single character that generated it or the index of its
+/// control sequence within the token_batch to which it belongs.
+//* =========================================================================
+struct compact_virtual_key
+{
+    //* =====================================================================
+    /// \brief The sequence index of a key generated from a single character.
+    //* =====================================================================
+    static constexpr std::uint32_t no_sequence =
+        (std::numeric_limits<std::uint32_t>::max)();
+
+    vk key = vk::nul;
+    vk_modifier modifiers = vk_modifier::none;
+    byte character = 0;
+    std::int32_t repeat_count = 0;
+    std::uint32_t sequence = no_sequence;
+
+    //* =====================================================================
+    /// \brief Relational operators for compact virtual keys
+    //* =====================================================================
+    [[nodiscard]] constexpr friend auto operator<=>(
+        compact_virtual_key const &lhs,
+        compact_virtual_key const &rhs) noexcept = default;
+};
+
+//* =========================================================================
+/// \brief The compact form of a control sequence: the index of the sequence
+/// within the token_batch to which it belongs.
+//* =========================================================================
+struct compact_control_sequence
+{
+    std::uint32_t index = 0;
+
+    //* =====================================================================
+    /// \brief Relational operators for compact control sequences
+    //* =====================================================================
+    [[nodiscard]] constexpr friend auto operator<=>(
+        compact_control_sequence const &lhs,
+        compact_control_sequence const &rhs) noexcept = default;
+};
+
+//* =========================================================================
+/// \brief A compact, trivially copyable form of a token.  Control sequences
+/// are held out of line in a token_batch, and the token refers to them by
+/// index.
+//* =========================================================================
+using compact_token = std::variant<
+    compact_virtual_key,
+    mouse::event,
+    compact_control_sequence,
+    paste>;
+
+static_assert(std::is_trivially_copyable_v<compact_token>);
+
+//* =========================================================================
+/// \brief A batch of tokens in compact form, together with the control
+/// sequences to which they refer.
+///
+/// \par Usage
+/// A token holds any of its alternatives, and so is as large as the largest
+/// of them: a control sequence, with its arguments.  Most input, however,
+/// is plain keypresses and mouse events.  A token_batch holds each token in
+/// a compact form that is a small fraction of that size, and stores the
+/// control sequences of the batch separately, so that iterating over the
+/// tokens of a batch touches far less memory.
+/// \par
+/// A batch may be cleared and reused, in which case, once it has grown to
+/// fit the usual amount of input, adding tokens to it does not allocate.
+//* =========================================================================
+class TERMINALPP_EXPORT token_batch
+{
+public:
+    //* =====================================================================
+    /// \brief Removes all tokens and control sequences from the batch.
+    //* =====================================================================
+    void clear() noexcept;
+
+    //* =====================================================================
+    /// \brief Adds the compact form of the token to the end of the batch.
+    /// Any control sequence within it is moved into the batch.
+    //* =====================================================================
+    void push_back(token &&tok);
+
+    //* =====================================================================
+    /// \brief Returns the tokens in the batch.
+    //* =====================================================================
+    [[nodiscard]] std::span<compact_token const> tokens() const noexcept;
+
+    //* =====================================================================
+    /// \brief Returns the last token in the batch, which may be modified
+    /// in place.  The batch must not be empty.
+    //* =====================================================================
+    [[nodiscard]] compact_token &back() noexcept;
+
+    //* =====================================================================
+    /// \brief Returns the control sequence with the given index.
+    //* =====================================================================
+    [[nodiscard]] control_sequence const &sequence(
+        std::uint32_t index) const noexcept;
+
+    //* =====================================================================
+    /// \brief Returns the full form of a token in the batch.
+    //* =====================================================================
+    [[nodiscard]] token expand(compact_token const &tok) const;
+
+    //* =====================================================================
+    /// \brief Returns the number of tokens in the batch.
+    //* =====================================================================
+    [[nodiscard]] std::size_t size() const noexcept;
+
+    //* =====================================================================
+    /// \brief Returns true if there are no tokens in the batch.
+    //* =====================================================================
+    [[nodiscard]] bool empty() const noexcept;
+
+private:
+    //* =====================================================================
+    /// \brief Moves a control sequence into the batch, returning its index.
+    //* =====================================================================
+    std::uint32_t store(control_sequence &&seq);
+
+    std::vector<compact_token> tokens_;
+    std::vector<control_sequence> sequences_;
+};
+
+}  // namespace terminalpp
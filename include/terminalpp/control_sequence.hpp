@@ -2,11 +2,261 @@
 
 #include "terminalpp/core.hpp"
 
+#include <algorithm>
+#include <array>
+#include <compare>
+#include <initializer_list>
 #include <iosfwd>
+#include <iterator>
+#include <utility>
 #include <vector>
+#include <cstddef>
+#include <cstdint>
 
 namespace terminalpp {
 
+//* =========================================================================
+/// \brief The arguments of a control sequence.
+///
+/// \par Usage
+/// The arguments are held as the text in which they were received, with
+/// each argument separated from the next by a semicolon.  For example, the
+/// arguments of the sequence "ESC[1;5A" are held as "1;5".  The individual
+/// arguments are only split out of the text when they are asked for, which
+/// means that the parser need not build a string for each argument of each
+/// sequence.  Interpreting the numeric arguments of the sequences that
+/// represent well-known keys does not use this form at all.
+/// \par
+/// Text of up to inline_capacity bytes, which is enough for the arguments
+/// of any well-known key, is held within the object itself.  Only longer
+/// text is allocated, so that parsing the usual input does not allocate.
+/// \par
+/// Arguments may be constructed from a list of their individual values, in
+/// which case they are joined with separators.  Note that this means that
+/// a list of one empty argument is indistinguishable from no arguments.
+//* =========================================================================
+class control_sequence_arguments
+{
+public:
+    //* =====================================================================
+    /// \brief An iterator over the arguments, each of which is a view of
+    /// part of the text.
+    //* =====================================================================
+    class const_iterator
+    {
+    public:
+        using iterator_concept = std::forward_iterator_tag;
+        using value_type = bytes;
+        using difference_type = std::ptrdiff_t;
+
+        constexpr const_iterator() noexcept = default;
+
+        constexpr const_iterator(bytes remaining, bool at_end) noexcept
+          : remaining_(remaining), at_end_(at_end)
+        {
+        }
+
+        [[nodiscard]] constexpr bytes operator*() const noexcept
+        {
+            return {
+                remaining_.begin(),
+                std::ranges::find(remaining_, separator)};
+        }
+
+        constexpr const_iterator &operator++() noexcept
+        {
+            auto const end = std::ranges::find(remaining_, separator);
+
+            if (end == remaining_.end())
+            {
+                remaining_ = {};
+                at_end_ = true;
+            }
+            else
+            {
+                remaining_ = {end + 1, remaining_.end()};
+            }
+
+            return *this;
+        }
+
+        constexpr const_iterator operator++(int) noexcept
+        {
+            auto result = *this;
+            ++*this;
+            return result;
+        }
+
+        [[nodiscard]] friend constexpr bool operator==(
+            const_iterator const &lhs, const_iterator const &rhs) noexcept
+        {
+            return lhs.at_end_ == rhs.at_end_
+                && lhs.remaining_.data() == rhs.remaining_.data()
+                && lhs.remaining_.size() == rhs.remaining_.size();
+        }
+
+    private:
+        bytes remaining_;
+        bool at_end_{true};
+    };
+
+    using value_type = bytes;
+    using iterator = const_iterator;
+
+    //* =====================================================================
+    /// \brief The byte that separates one argument from the next.
+    //* =====================================================================
+    static constexpr byte separator = ';';
+
+    //* =====================================================================
+    /// \brief The length of the longest text that is held without
+    /// allocating.
+    //* =====================================================================
+    static constexpr std::size_t inline_capacity = 7;
+
+    //* =====================================================================
+    /// \brief Constructs an empty set of arguments.
+    //* =====================================================================
+    constexpr control_sequence_arguments() noexcept = default;
+
+    //* =====================================================================
+    /// \brief Constructs arguments with the given values.
+    //* =====================================================================
+    constexpr control_sequence_arguments(std::initializer_list<bytes> values)
+    {
+        for (bool first = true; auto const value : values)
+        {
+            if (!std::exchange(first, false))
+            {
+                append({&separator, 1});
+            }
+
+            append(value);
+        }
+    }
+
+    //* =====================================================================
+    /// \brief Returns arguments that are held as the given text, in which
+    /// they are separated by semicolons.
+    //* =====================================================================
+    [[nodiscard]] static constexpr control_sequence_arguments from_text(
+        bytes text)
+    {
+        control_sequence_arguments result;
+        result.append(text);
+        return result;
+    }
+
+    //* =====================================================================
+    /// \brief Returns the text of the arguments, including their
+    /// separators.
+    //* =====================================================================
+    [[nodiscard]] constexpr bytes text() const noexcept
+    {
+        return overflow_text_.empty()
+                 ? bytes{inline_text_.data(), inline_size_}
+                 : bytes{overflow_text_.data(), overflow_text_.size()};
+    }
+
+    //* =====================================================================
+    /// \brief Returns whether there are no arguments.
+    //* =====================================================================
+    [[nodiscard]] constexpr bool empty() const noexcept
+    {
+        return text().empty();
+    }
+
+    //* =====================================================================
+    /// \brief Returns the number of arguments.
+    //* =====================================================================
+    [[nodiscard]] constexpr std::size_t size() const noexcept
+    {
+        return empty() ? 0
+                       : static_cast<std::size_t>(
+                             std::ranges::count(text(), separator))
+                             + 1;
+    }
+
+    //* =====================================================================
+    /// \brief Returns the argument at the given index, which must be less
+    /// than size().
+    //* =====================================================================
+    [[nodiscard]] constexpr bytes operator[](std::size_t index) const noexcept
+    {
+        return *std::ranges::next(begin(), static_cast<std::ptrdiff_t>(index));
+    }
+
+    //* =====================================================================
+    /// \brief Returns an iterator to the first argument.
+    //* =====================================================================
+    [[nodiscard]] constexpr const_iterator begin() const noexcept
+    {
+        return empty() ? const_iterator{} : const_iterator{text(), false};
+    }
+
+    //* =====================================================================
+    /// \brief Returns an iterator past the last argument.
+    //* =====================================================================
+    [[nodiscard]] constexpr const_iterator end() const noexcept
+    {
+        return {};
+    }
+
+    //* =====================================================================
+    /// \brief Relational operators for arguments
+    //* =====================================================================
+    [[nodiscard]] friend constexpr std::strong_ordering operator<=>(
+        control_sequence_arguments const &lhs,
+        control_sequence_arguments const &rhs) noexcept
+    {
+        auto const lhs_text = lhs.text();
+        auto const rhs_text = rhs.text();
+
+        return std::lexicographical_compare_three_way(
+            lhs_text.begin(), lhs_text.end(), rhs_text.begin(), rhs_text.end());
+    }
+
+    //* =====================================================================
+    /// \brief Equality operator for arguments
+    //* =====================================================================
+    [[nodiscard]] friend constexpr bool operator==(
+        control_sequence_arguments const &lhs,
+        control_sequence_arguments const &rhs) noexcept
+    {
+        return std::ranges::equal(lhs.text(), rhs.text());
+    }
+
+private:
+    //* =====================================================================
+    /// \brief Appends the data to the text, moving the text out of the
+    /// object if it no longer fits.
+    //* =====================================================================
+    constexpr void append(bytes data)
+    {
+        if (overflow_text_.empty()
+            && std::size_t{inline_size_} + data.size() <= inline_capacity)
+        {
+            std::ranges::copy(data, inline_text_.begin() + inline_size_);
+            inline_size_ =
+                static_cast<std::uint8_t>(inline_size_ + data.size());
+            return;
+        }
+
+        if (overflow_text_.empty())
+        {
+            overflow_text_.assign(
+                inline_text_.begin(), inline_text_.begin() + inline_size_);
+            inline_size_ = 0;
+        }
+
+        overflow_text_.insert(overflow_text_.end(), data.begin(), data.end());
+    }
+
+    std::array<byte, inline_capacity> inline_text_{};
+    std::uint8_t inline_size_{0};
+    std::vector<byte> overflow_text_;
+};
+
 //* =========================================================================
 /// \brief A class that encapsulates an ANSI control sequence.
 /// In the sequence "ESC[x;h;yC", '[' is the initiator, "C" is the command,
@@ -21,8 +271,8 @@ struct control_sequence
     byte initiator = 0;
     byte command = 0;
     bool meta = false;
-    std::vector<byte_storage> arguments;
     byte extender = 0;
+    control_sequence_arguments arguments;
 
     //* =====================================================================
     /// \brief Relational operators for control sequences
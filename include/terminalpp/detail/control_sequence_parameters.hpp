@@ -0,0 +1,220 @@
+#pragma once
+
+#include "terminalpp/core.hpp"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <optional>
+#include <span>
+#include <tuple>
+#include <cstddef>
+#include <cstdint>
+
+namespace terminalpp::detail {
+
+//* =========================================================================
+/// \brief The numeric parameters of a control sequence.
+///
+/// \par Usage
+/// In the sequence "ESC[1;5A", the parameters are 1 and 5.  Parameters may
+/// be omitted (as in "ESC[;5A"), in which case the command applies its own
+/// default, and may carry colon-separated sub-parameters (as in
+/// "ESC[4:3m").  This class holds the values of each parameter and
+/// sub-parameter in a fixed-size array, so no allocation is required, and
+/// values are accumulated digit by digit as the parser receives them, so
+/// they need not be parsed again when the sequence is interpreted.
+/// \par
+/// Parameters beyond the capacity are discarded, and values that are too
+/// large to represent are saturated.
+//* =========================================================================
+class control_sequence_parameters
+{
+public:
+    using value_type = std::uint32_t;
+
+    //* =====================================================================
+    /// \brief The total number of parameters and sub-parameters that can be
+    /// held.
+    //* =====================================================================
+    static constexpr std::size_t capacity = 16;
+
+    //* =====================================================================
+    /// \brief The value stored for a parameter that was omitted.
+    //* =====================================================================
+    static constexpr value_type omitted =
+        (std::numeric_limits<value_type>::max)();
+
+    //* =====================================================================
+    /// \brief The largest value that a parameter may hold.
+    //* =====================================================================
+    static constexpr value_type max_value = omitted - 1;
+
+    //* =====================================================================
+    /// \brief Returns the number of parameters, not counting
+    /// sub-parameters.
+    //* =====================================================================
+    [[nodiscard]] constexpr std::size_t size() const noexcept
+    {
+        return parameter_count_;
+    }
+
+    //* =====================================================================
+    /// \brief Returns true if there are no parameters.
+    //* =====================================================================
+    [[nodiscard]] constexpr bool empty() const noexcept
+    {
+        return parameter_count_ == 0;
+    }
+
+    //* =====================================================================
+    /// \brief Returns the value of the parameter at the given index, or an
+    /// empty optional if it was omitted or not present.
+    //* =====================================================================
+    [[nodiscard]] constexpr std::optional<value_type> get(
+        std::size_t index) const noexcept
+    {
+        if (index >= parameter_count_
+            || values_[starts_[index]] == omitted)
+        {
+            return std::nullopt;
+        }
+
+        return values_[starts_[index]];
+    }
+
+    //* =====================================================================
+    /// \brief Returns the value of the parameter at the given index, or the
+    /// given default if it was omitted or not present.
+    //* =====================================================================
+    [[nodiscard]] constexpr value_type get_or(
+        std::size_t index, value_type default_value) const noexcept
+    {
+        return get(index).value_or(default_value);
+    }
+
+    //* =====================================================================
+    /// \brief Returns the sub-parameters of the parameter at the given
+    /// index.  Omitted sub-parameters hold the value omitted.
+    //* =====================================================================
+    [[nodiscard]] constexpr std::span<value_type const> sub_parameters(
+        std::size_t index) const noexcept
+    {
+        if (index >= parameter_count_)
+        {
+            return {};
+        }
+
+        auto const first = starts_[index] + std::size_t{1};
+        auto const last = index + 1 < parameter_count_
+                            ? std::size_t{starts_[index + 1]}
+                            : value_count_;
+
+        return std::span{values_}.subspan(first, last - first);
+    }
+
+    //* =====================================================================
+    /// \brief Removes all parameters.
+    //* =====================================================================
+    constexpr void clear() noexcept
+    {
+        parameter_count_ = 0;
+        value_count_ = 0;
+        open_ = false;
+        overflowed_ = false;
+    }
+
+    //* =====================================================================
+    /// \brief Appends a decimal digit to the value currently being
+    /// received, beginning a new parameter if necessary.
+    //* =====================================================================
+    constexpr void append_digit(byte digit) noexcept
+    {
+        auto *const value = current_value();
+
+        if (value != nullptr)
+        {
+            auto const accumulated =
+                (*value == omitted ? value_type{0} : *value);
+            auto const digit_value = static_cast<value_type>(digit - '0');
+
+            *value = accumulated > (max_value - digit_value) / 10
+                       ? max_value
+                       : accumulated * 10 + digit_value;
+        }
+    }
+
+    //* =====================================================================
+    /// \brief Completes the current parameter.  If nothing has been
+    /// received for it, then it is recorded as omitted.
+    //* =====================================================================
+    constexpr void end_parameter() noexcept
+    {
+        std::ignore = current_value();
+        open_ = false;
+    }
+
+    //* =====================================================================
+    /// \brief Completes the current parameter or sub-parameter and begins a
+    /// new sub-parameter of the current parameter.
+    //* =====================================================================
+    constexpr void end_sub_parameter() noexcept
+    {
+        std::ignore = current_value();
+        overflowed_ = value_count_ == capacity;
+
+        if (!overflowed_)
+        {
+            values_[value_count_++] = omitted;
+        }
+    }
+
+    //* =====================================================================
+    /// \brief Equality operator
+    //* =====================================================================
+    [[nodiscard]] friend constexpr bool operator==(
+        control_sequence_parameters const &lhs,
+        control_sequence_parameters const &rhs) noexcept
+    {
+        return lhs.parameter_count_ == rhs.parameter_count_
+            && std::ranges::equal(
+                   std::span{lhs.values_}.first(lhs.value_count_),
+                   std::span{rhs.values_}.first(rhs.value_count_))
+            && std::ranges::equal(
+                   std::span{lhs.starts_}.first(lhs.parameter_count_),
+                   std::span{rhs.starts_}.first(rhs.parameter_count_));
+    }
+
+private:
+    //* =====================================================================
+    /// \brief Returns the value currently being received, opening a new
+    /// parameter for it if there is none.  Returns nullptr if the capacity
+    /// has been exhausted.
+    //* =====================================================================
+    constexpr value_type *current_value() noexcept
+    {
+        if (!open_)
+        {
+            open_ = true;
+            overflowed_ = value_count_ == capacity;
+
+            if (!overflowed_)
+            {
+                starts_[parameter_count_++] =
+                    static_cast<std::uint8_t>(value_count_);
+                values_[value_count_++] = omitted;
+            }
+        }
+
+        return overflowed_ ? nullptr : &values_[value_count_ - 1];
+    }
+
+    std::array<value_type, capacity> values_{};
+    std::array<std::uint8_t, capacity> starts_{};
+    std::size_t parameter_count_{0};
+    std::size_t value_count_{0};
+    bool open_{false};
+    bool overflowed_{false};
+};
+
+}  // namespace terminalpp::detail
@@ -0,0 +1,292 @@
+#pragma once
+
+#include "terminalpp/ansi/csi.hpp"
+#include "terminalpp/behaviour.hpp"
+#include "terminalpp/core.hpp"
+#include "terminalpp/detail/ascii.hpp"
+#include "terminalpp/detail/element_difference.hpp"
+#include "terminalpp/detail/integer_encoding.hpp"
+#include "terminalpp/point.hpp"
+#include "terminalpp/write_continuation.hpp"
+
+#include <algorithm>
+#include <array>
+#include <initializer_list>
+#include <optional>
+#include <cstddef>
+
+namespace terminalpp::detail {
+
+//* =========================================================================
+/// \brief The individual operations from which a route for the cursor is
+/// built.
+//* =========================================================================
+enum class cursor_movement
+{
+    none,
+    cursor_position,
+    cursor_horizontal_absolute,
+    line_position_absolute,
+    cursor_forward,
+    cursor_backward,
+    cursor_up,
+    cursor_down,
+    carriage_return,
+    line_feed,
+    backspace,
+};
+
+//* =========================================================================
+/// \brief A single movement, with either the absolute destination or the
+/// relative distance that it moves, as appropriate to the kind of movement.
+//* =========================================================================
+struct cursor_step
+{
+    cursor_movement kind_;
+    point destination_;
+    coordinate_type distance_;
+};
+
+//* =========================================================================
+/// \brief A short list of steps.
+///
+/// This is used both for the candidate steps in a single direction and for
+/// a whole route, which never needs more than three steps (e.g. CR, LF,
+/// CUF).  It has a fixed capacity so that planning a route does not
+/// allocate.
+//* =========================================================================
+class cursor_route
+{
+public:
+    constexpr cursor_route() = default;
+
+    constexpr cursor_route(std::initializer_list<cursor_step> steps)
+    {
+        std::ranges::for_each(
+            steps, [this](cursor_step const &stp) { push_back(stp); });
+    }
+
+    constexpr void push_back(cursor_step const &stp)
+    {
+        steps_[size_++] = stp;
+    }
+
+    [[nodiscard]] constexpr cursor_step const *begin() const
+    {
+        return steps_.data();
+    }
+
+    [[nodiscard]] constexpr cursor_step const *end() const
+    {
+        return steps_.data() + size_;
+    }
+
+private:
+    std::array<cursor_step, 3> steps_{};
+    std::size_t size_{0};
+};
+
+//* =========================================================================
+/// \brief Writes a cursor position (CUP) sequence for the destination,
+/// omitting any parameters that the terminal defaults.
+//* =========================================================================
+template <class WriteContinuation>
+void write_cursor_position(
+    point const destination, behaviour const &beh, WriteContinuation &&wc)
+{
+    csi(beh, wc);
+
+    if (destination.x_ == 0 && destination.y_ == 0)
+    {
+        if (!beh.supports_cup_default_all)
+        {
+            write_parameters(wc, 1, 1);
+        }
+    }
+    else if (destination.x_ == 0 && beh.supports_cup_default_column)
+    {
+        write_parameters(wc, destination.y_ + 1);
+    }
+    else if (destination.y_ == 0 && beh.supports_cup_default_row)
+    {
+        static constexpr byte separator[] = {ansi::ps};
+        write_static(wc, separator);
+        write_parameters(wc, destination.x_ + 1);
+    }
+    else
+    {
+        write_parameters(wc, destination.y_ + 1, destination.x_ + 1);
+    }
+
+    static constexpr byte cursor_position_suffix[] = {
+        ansi::csi::cursor_position};
+
+    write_static(wc, cursor_position_suffix);
+}
+
+//* =========================================================================
+/// \brief Writes a sequence that moves the cursor to an absolute row or
+/// column.
+//* =========================================================================
+template <class WriteContinuation>
+void write_absolute_movement(
+    coordinate_type const position,
+    bool const supports_default,
+    byte const command,
+    behaviour const &beh,
+    WriteContinuation &&wc)
+{
+    csi(beh, wc);
+
+    if (position != 0 || !supports_default)
+    {
+        write_parameters(wc, position + 1);
+    }
+
+    byte const suffix[] = {command};
+    wc(suffix);
+}
+
+//* =========================================================================
+/// \brief Writes a sequence that moves the cursor by a distance.
+//* =========================================================================
+template <class WriteContinuation>
+void write_relative_movement(
+    coordinate_type const distance,
+    byte const command,
+    behaviour const &beh,
+    WriteContinuation &&wc)
+{
+    csi(beh, wc);
+
+    if (distance != 1)
+    {
+        write_parameters(wc, distance);
+    }
+
+    byte const suffix[] = {command};
+    wc(suffix);
+}
+
+//* =========================================================================
+/// \brief Writes a control character the given number of times.
+//* =========================================================================
+template <class WriteContinuation>
+void write_repeated_control(
+    coordinate_type const count, byte const control, WriteContinuation &&wc)
+{
+    byte const data[] = {control};
+
+    for (coordinate_type index = 0; index < count; ++index)
+    {
+        wc(data);
+    }
+}
+
+//* =========================================================================
+/// \brief Writes the sequence for a single step of a cursor route.
+//* =========================================================================
+template <class WriteContinuation>
+void write_cursor_step(
+    cursor_step const &stp, behaviour const &beh, WriteContinuation &&wc)
+{
+    switch (stp.kind_)
+    {
+        case cursor_movement::none:
+            break;
+
+        case cursor_movement::cursor_position:
+            write_cursor_position(stp.destination_, beh, wc);
+            break;
+
+        case cursor_movement::cursor_horizontal_absolute:
+            write_absolute_movement(
+                stp.destination_.x_,
+                beh.supports_cha_default,
+                ansi::csi::cursor_horizontal_absolute,
+                beh,
+                wc);
+            break;
+
+        case cursor_movement::line_position_absolute:
+            write_absolute_movement(
+                stp.destination_.y_,
+                beh.supports_vpa_default,
+                ansi::csi::line_position_absolute,
+                beh,
+                wc);
+            break;
+
+        case cursor_movement::cursor_forward:
+            write_relative_movement(
+                stp.distance_, ansi::csi::cursor_forward, beh, wc);
+            break;
+
+        case cursor_movement::cursor_backward:
+            write_relative_movement(
+                stp.distance_, ansi::csi::cursor_backward, beh, wc);
+            break;
+
+        case cursor_movement::cursor_up:
+            write_relative_movement(
+                stp.distance_, ansi::csi::cursor_up, beh, wc);
+            break;
+
+        case cursor_movement::cursor_down:
+            write_relative_movement(
+                stp.distance_, ansi::csi::cursor_down, beh, wc);
+            break;
+
+        case cursor_movement::carriage_return:
+            write_repeated_control(1, ascii::cr, wc);
+            break;
+
+        case cursor_movement::line_feed:
+            write_repeated_control(stp.distance_, ascii::lf, wc);
+            break;
+
+        case cursor_movement::backspace:
+            write_repeated_control(stp.distance_, ascii::bs, wc);
+            break;
+    }
+}
+
+//* =========================================================================
+/// \brief Returns the route from source to destination that can be written
+/// in the fewest bytes.  Where routes are of equal cost, the one considered
+/// first is preferred.
+///
+/// Planning a route does not depend on where its output is written, so this
+/// is compiled in the library, while the writing of the route is inlined
+/// into the caller.
+//* =========================================================================
+TERMINALPP_EXPORT
+[[nodiscard]] cursor_route plan_cursor_route(
+    point const &source, point const &destination, behaviour const &beh);
+
+//* =========================================================================
+/// \brief Writes the shortest sequence that moves the cursor from its
+/// current position, if known, to the destination.
+//* =========================================================================
+template <class WriteContinuation>
+void move_cursor(
+    std::optional<point> const &cursor_position,
+    point const destination,
+    behaviour const &beh,
+    WriteContinuation &&wc)
+{
+    if (!cursor_position)
+    {
+        write_cursor_position(destination, beh, wc);
+    }
+    else if (*cursor_position != destination)
+    {
+        for (auto const &stp :
+             plan_cursor_route(*cursor_position, destination, beh))
+        {
+            write_cursor_step(stp, beh, wc);
+        }
+    }
+}
+
+}  // namespace terminalpp::detail
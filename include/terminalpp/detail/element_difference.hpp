@@ -11,11 +11,11 @@
 #include "terminalpp/character_set.hpp"
 #include "terminalpp/colour.hpp"
 #include "terminalpp/core.hpp"
+#include "terminalpp/detail/integer_encoding.hpp"
 #include "terminalpp/detail/overloaded.hpp"
 #include "terminalpp/effect.hpp"
 #include "terminalpp/element.hpp"
-
-#include <format>
+#include "terminalpp/write_continuation.hpp"
 
 #include <optional>
 #include <utility>
@@ -29,7 +29,8 @@ template <class WriteContinuation>
 constexpr void csi(
     behaviour const & /*terminal_behaviour*/, WriteContinuation &&wc)
 {
-    wc({std::cbegin(ansi::control7::csi), std::cend(ansi::control7::csi)});
+    write_static(
+        wc, {std::cbegin(ansi::control7::csi), std::cend(ansi::control7::csi)});
 }
 
 //* =========================================================================
@@ -39,7 +40,8 @@ template <class WriteContinuation>
 constexpr void osc(
     behaviour const & /*terminal_behaviour*/, WriteContinuation &&wc)
 {
-    wc({std::cbegin(ansi::control7::osc), std::cend(ansi::control7::osc)});
+    write_static(
+        wc, {std::cbegin(ansi::control7::osc), std::cend(ansi::control7::osc)});
 }
 
 //* =========================================================================
@@ -49,7 +51,8 @@ template <class WriteContinuation>
 constexpr void st(
     behaviour const & /*terminal_behaviour*/, WriteContinuation &&wc)
 {
-    wc({std::cbegin(ansi::control7::st), std::cend(ansi::control7::st)});
+    write_static(
+        wc, {std::cbegin(ansi::control7::st), std::cend(ansi::control7::st)});
 }
 
 //* =========================================================================
@@ -94,8 +97,8 @@ constexpr void designate_g0_charset(
     bytes const select_g0_charset = {
         std::cbegin(ansi::set_charset_g0), std::cend(ansi::set_charset_g0)};
 
-    wc(select_g0_charset);
-    wc(encode_character_set(set));
+    write_static(wc, select_g0_charset);
+    write_static(wc, encode_character_set(set));
 }
 
 //* =========================================================================
@@ -108,7 +111,7 @@ constexpr void select_utf8_charset(WriteContinuation &&wc)
         std::cbegin(ansi::select_utf8_character_set),
         std::cend(ansi::select_utf8_character_set)};
 
-    wc(select_utf8_charset_command);
+    write_static(wc, select_utf8_charset_command);
 }
 
 //* =========================================================================
@@ -121,7 +124,7 @@ constexpr void select_default_charset(WriteContinuation &&wc)
         std::cbegin(ansi::select_default_character_set),
         std::cend(ansi::select_default_character_set)};
 
-    wc(select_default_charset_command);
+    write_static(wc, select_default_charset_command);
 }
 
 //* =========================================================================
@@ -183,7 +186,7 @@ constexpr void change_effect(
                     wc(separator);
                 }
 
-                wc(to_bytes(std::format("{}", int(EffectType::normal))));
+                write_parameters(wc, int(EffectType::normal));
             }
         }
 
@@ -192,7 +195,7 @@ constexpr void change_effect(
             wc(separator);
         }
 
-        wc(to_bytes(std::format("{}", int(dest.value_))));
+        write_parameters(wc, int(dest.value_));
     }
 }
 
@@ -217,25 +220,33 @@ constexpr void change_foreground_colour(
         std::visit(
             overloaded{
                 [&wc](low_colour const &col) {
-                    wc(to_bytes(std::format(
-                        "{}",
+                    write_parameters(
+                        wc,
                         static_cast<int>(col.value_)
-                            + ansi::graphics::foreground_colour_base)));
+                            + ansi::graphics::foreground_colour_base);
                 },
                 [&wc](high_colour const &col) {
-                    wc(to_bytes(
-                        std::format("38;5;{}", static_cast<int>(col.value_))));
+                    write_parameters(
+                        wc,
+                        ansi::graphics::extended_foreground_colour,
+                        ansi::graphics::extended_colour_indexed,
+                        col.value_);
                 },
                 [&wc](greyscale_colour const &col) {
-                    wc(to_bytes(
-                        std::format("38;5;{}", static_cast<int>(col.shade_))));
+                    write_parameters(
+                        wc,
+                        ansi::graphics::extended_foreground_colour,
+                        ansi::graphics::extended_colour_indexed,
+                        col.shade_);
                 },
                 [&wc](true_colour const &col) {
-                    wc(to_bytes(std::format(
-                        "38;2;{};{};{}",
-                        static_cast<int>(col.red_),
-                        static_cast<int>(col.green_),
-                        static_cast<int>(col.blue_))));
+                    write_parameters(
+                        wc,
+                        ansi::graphics::extended_foreground_colour,
+                        ansi::graphics::extended_colour_rgb,
+                        col.red_,
+                        col.green_,
+                        col.blue_);
                 }},
             dest.value_);
     }
@@ -262,25 +273,33 @@ constexpr void change_background_colour(
         std::visit(
             overloaded{
                 [&wc](low_colour const &col) {
-                    wc(to_bytes(std::format(
-                        "{}",
+                    write_parameters(
+                        wc,
                         static_cast<int>(col.value_)
-                            + ansi::graphics::background_colour_base)));
+                            + ansi::graphics::background_colour_base);
                 },
                 [&wc](high_colour const &col) {
-                    wc(to_bytes(
-                        std::format("48;5;{}", static_cast<int>(col.value_))));
+                    write_parameters(
+                        wc,
+                        ansi::graphics::extended_background_colour,
+                        ansi::graphics::extended_colour_indexed,
+                        col.value_);
                 },
                 [&wc](greyscale_colour const &col) {
-                    wc(to_bytes(
-                        std::format("48;5;{}", static_cast<int>(col.shade_))));
+                    write_parameters(
+                        wc,
+                        ansi::graphics::extended_background_colour,
+                        ansi::graphics::extended_colour_indexed,
+                        col.shade_);
                 },
                 [&wc](true_colour const &col) {
-                    wc(to_bytes(std::format(
-                        "48;2;{};{};{}",
-                        static_cast<int>(col.red_),
-                        static_cast<int>(col.green_),
-                        static_cast<int>(col.blue_))));
+                    write_parameters(
+                        wc,
+                        ansi::graphics::extended_background_colour,
+                        ansi::graphics::extended_colour_rgb,
+                        col.red_,
+                        col.green_,
+                        col.blue_);
                 }},
             dest.value_);
     }
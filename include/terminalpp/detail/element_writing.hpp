@@ -0,0 +1,130 @@
+#pragma once
+
+#include "terminalpp/attribute.hpp"
+#include "terminalpp/behaviour.hpp"
+#include "terminalpp/character_set.hpp"
+#include "terminalpp/core.hpp"
+#include "terminalpp/detail/element_difference.hpp"
+#include "terminalpp/element.hpp"
+#include "terminalpp/terminal_state.hpp"
+
+#include <algorithm>
+#include <cstddef>
+
+namespace terminalpp::detail {
+
+//* =========================================================================
+/// \brief Writes the bytes of the element's glyph.
+//* =========================================================================
+template <class WriteContinuation>
+void write_glyph(element const &elem, WriteContinuation &&wc)
+{
+    if (elem.glyph_.charset_ == charset::utf8)
+    {
+        std::size_t index = 0;
+
+        for (; index < sizeof(elem.glyph_.ucharacter_)
+               && elem.glyph_.ucharacter_[index] != '\0';
+             ++index)
+        {
+            if ((elem.glyph_.ucharacter_[index] & 0x80) == 0)
+            {
+                break;
+            }
+        }
+
+        wc(bytes{elem.glyph_.ucharacter_, std::max(index, std::size_t{1U})});
+    }
+    else
+    {
+        wc(bytes{&elem.glyph_.character_, 1});
+    }
+}
+
+//* =========================================================================
+/// \brief Changes attribute from the source to destination, using the
+/// terminal's attribute transition cache if it has one.
+//* =========================================================================
+template <class WriteContinuation>
+void change_attribute(
+    attribute const &source,
+    attribute const &dest,
+    behaviour const &beh,
+    terminal_state &state,
+    WriteContinuation &&wc)
+{
+    if (state.attribute_transition_cache_ && source != dest)
+    {
+        wc(state.attribute_transition_cache_->get(
+            source, dest, [&](byte_storage &encoding) {
+                change_attribute(source, dest, beh, [&encoding](bytes data) {
+                    encoding.append(data.begin(), data.end());
+                });
+            }));
+    }
+    else
+    {
+        change_attribute(source, dest, beh, wc);
+    }
+}
+
+//* =========================================================================
+/// \brief Records that the cursor has moved past an element that was
+/// written at its position.
+//* =========================================================================
+inline void advance_cursor_position(terminal_state &state)
+{
+    if (state.cursor_position_)
+    {
+        if (++state.cursor_position_->x_ == state.terminal_size_.width_)
+        {
+            // Terminals differ in their behaviour when reaching the
+            // end of the line.  Some wrap to the next line, some bounce
+            // against the edge.  To maintain consistency, forget the
+            // current cursor position.
+            state.cursor_position_ = {};
+        }
+    }
+}
+
+//* =========================================================================
+/// \brief Writes the element, together with any changes of character set
+/// and attribute from the last element that was written.
+//* =========================================================================
+template <class WriteContinuation>
+void write_element(
+    element const &elem,
+    behaviour const &beh,
+    terminal_state &state,
+    WriteContinuation &&wc)
+{
+    static constexpr element default_element{};
+    auto const &last_element = state.last_element_.has_value()
+                                 ? *state.last_element_
+                                 : default_element;
+
+    change_charset(
+        last_element.glyph_.charset_, elem.glyph_.charset_, beh, wc);
+    change_attribute(
+        last_element.attribute_, elem.attribute_, beh, state, wc);
+    write_glyph(elem, wc);
+
+    state.last_element_ = elem;
+    advance_cursor_position(state);
+}
+
+//* =========================================================================
+/// \brief Writes the default attribute if the current attribute is unknown.
+//* =========================================================================
+template <class WriteContinuation>
+void write_optional_default_attribute(
+    behaviour const &beh, terminal_state &state, WriteContinuation &&wc)
+{
+    if (!state.last_element_)
+    {
+        default_attribute(beh, wc);
+        state.last_element_ = element{};
+    }
+}
+
+}  // namespace terminalpp::detail
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "terminalpp/ansi/protocol.hpp"
+#include "terminalpp/core.hpp"
+
+#include <algorithm>
+#include <array>
+#include <concepts>  // IWYU pragma: keep
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <cstddef>
+
+namespace terminalpp::detail {
+
+//* =========================================================================
+/// \brief The maximum number of bytes required to encode a value of the
+/// given integral type in decimal, including any sign.
+//* =========================================================================
+template <std::integral Integer>
+inline constexpr std::size_t max_encoded_integer_length =
+    std::numeric_limits<Integer>::digits10 + 2;
+
+//* =========================================================================
+/// \brief Encodes the integer as decimal digits into the buffer at out,
+/// returning a pointer to one past the last byte written.
+///
+/// The buffer must have room for max_encoded_integer_length<Integer>
+/// bytes.
+//* =========================================================================
+template <std::integral Integer>
+constexpr byte *encode_integer(Integer value, byte *out) noexcept
+{
+    using unsigned_type = std::make_unsigned_t<Integer>;
+    auto magnitude = static_cast<unsigned_type>(value);
+
+    if constexpr (std::is_signed_v<Integer>)
+    {
+        if (value < 0)
+        {
+            *out++ = '-'_tb;
+            magnitude = static_cast<unsigned_type>(unsigned_type{0} - magnitude);
+        }
+    }
+
+    // Digits are produced least-significant first, so are written
+    // backwards and then reversed into place.
+    auto *const first_digit = out;
+
+    do
+    {
+        *out++ = static_cast<byte>('0' + magnitude % 10U);
+        magnitude = static_cast<unsigned_type>(magnitude / 10U);
+    } while (magnitude != 0);
+
+    std::reverse(first_digit, out);
+    return out;
+}
+
+//* =========================================================================
+/// \brief Writes the values as a list of decimal parameters separated by
+/// the parameter separator, e.g. "38;5;196".
+///
+/// The parameters are assembled in a buffer on the stack and are written
+/// to the continuation in a single call, so no allocation takes place.
+//* =========================================================================
+template <class WriteContinuation, std::integral... Integers>
+constexpr void write_parameters(WriteContinuation &&wc, Integers... values)
+{
+    std::array<byte, ((max_encoded_integer_length<Integers> + 1) + ...)>
+        buffer{};
+    auto *out = buffer.data();
+
+    auto append = [&out, separate = false](auto value) mutable {
+        if (std::exchange(separate, true))
+        {
+            *out++ = ansi::ps;
+        }
+
+        out = encode_integer(value, out);
+    };
+
+    (append(values), ...);
+
+    wc(bytes{buffer.data(), out});
+}
+
+}  // namespace terminalpp::detail
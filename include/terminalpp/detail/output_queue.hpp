@@ -0,0 +1,78 @@
+#pragma once
+
+#include "terminalpp/core.hpp"
+
+#include <sys/uio.h>
+
+#include <deque>
+#include <span>
+#include <cstddef>
+
+namespace terminalpp::detail {
+
+//* =========================================================================
+/// \brief A queue of the output that a non-blocking descriptor would not
+/// accept, to be sent with a gathering write once it becomes writable.
+//* =========================================================================
+class TERMINALPP_EXPORT output_queue
+{
+public:
+    //* =====================================================================
+    /// \brief Copies the data onto the end of the queue.
+    //* =====================================================================
+    void push(bytes data);
+
+    //* =====================================================================
+    /// \brief Copies the fragments onto the end of the queue, less the given
+    /// number of bytes from their front that have already been sent.
+    //* =====================================================================
+    void push(std::span<bytes const> data, std::size_t sent);
+
+    //* =====================================================================
+    /// \brief Fills the fragments with the unsent data at the front of the
+    /// queue, and returns the number of fragments filled.
+    //* =====================================================================
+    [[nodiscard]] std::size_t gather(std::span<iovec> fragments);
+
+    //* =====================================================================
+    /// \brief Removes the given number of sent bytes from the front of the
+    /// queue.
+    //* =====================================================================
+    void consume(std::size_t count);
+
+    //* =====================================================================
+    /// \brief Removes everything from the queue.
+    //* =====================================================================
+    void clear();
+
+    //* =====================================================================
+    /// \brief Returns whether the queue is empty.
+    //* =====================================================================
+    [[nodiscard]] bool empty() const;
+
+    //* =====================================================================
+    /// \brief Returns the number of bytes in the queue.
+    //* =====================================================================
+    [[nodiscard]] std::size_t size() const;
+
+private:
+    std::deque<byte_storage> fragments_;
+    std::size_t offset_{0};
+    std::size_t size_{0};
+};
+
+//* =========================================================================
+/// \brief Fills the fragments with the data, and returns the number of
+/// fragments filled.
+//* =========================================================================
+TERMINALPP_EXPORT
+std::size_t gather(std::span<bytes const> data, std::span<iovec> fragments);
+
+//* =========================================================================
+/// \brief Returns whether the last failed operation on a non-blocking
+/// descriptor may be retried later, rather than being a real error.
+//* =========================================================================
+TERMINALPP_EXPORT
+bool would_block();
+
+}  // namespace terminalpp::detail
@@ -1,22 +1,109 @@
 #pragma once
 
 #include "terminalpp/core.hpp"
+#include "terminalpp/detail/control_sequence_parameters.hpp"
 #include "terminalpp/token.hpp"
 
+#include <deque>
+#include <iterator>
 #include <optional>
+#include <utility>
 #include <vector>
+#include <cstddef>
+#include <cstdint>
 
 namespace terminalpp::detail {
 
 class TERMINALPP_EXPORT parser
 {
 public:
-    parser();
+    //* =====================================================================
+    /// \brief The default for the largest amount of paste text that is
+    /// buffered before it is reported.
+    //* =====================================================================
+    static constexpr std::size_t default_max_paste_size = 1024 * 1024;
 
+    //* =====================================================================
+    /// \brief Constructor
+    ///
+    /// A bracketed paste whose text spans more than one input is buffered
+    /// until its end marker arrives.  So that a peer that never ends a
+    /// paste cannot cause the buffer to grow without limit, once it holds
+    /// max_paste_size bytes, its text is reported as a paste and the rest
+    /// of the paste continues to be read into an empty buffer.  The final
+    /// part of a paste that is reported in this way may be empty.
+    //* =====================================================================
+    explicit parser(std::size_t max_paste_size = default_max_paste_size);
+
+    //* =====================================================================
+    /// \brief Parses a single byte of input, returning the token that it
+    /// completes, if any.
+    ///
+    /// Any paste token that was returned from a previous call is
+    /// invalidated.
+    //* =====================================================================
     std::optional<terminalpp::token> operator()(byte input);
 
+    //* =====================================================================
+    /// \brief Parses a span of input, writing each token that it completes
+    /// to the output iterator, which is then returned.
+    ///
+    /// In the idle state, runs of ordinary characters are converted
+    /// directly into virtual keys; only the bytes that may begin a sequence
+    /// are passed through the state machine.  Similarly, bracketed pastes
+    /// are searched for their end marker in bulk, and a paste that begins
+    /// and ends within the input refers directly to it.
+    ///
+    /// Each paste token remains valid until the parser is next called, even
+    /// if more pastes follow it in the same input.
+    //* =====================================================================
+    template <std::output_iterator<terminalpp::token> OutputIterator>
+    OutputIterator parse(bytes input, OutputIterator out)
+    {
+        release_pastes();
+
+        while (!input.empty())
+        {
+            if (state_ == state::paste)
+            {
+                if (auto result = parse_paste(input); result.has_value())
+                {
+                    *out++ = std::move(*result);
+                }
+
+                continue;
+            }
+
+            if (state_ == state::idle)
+            {
+                auto const run_length = ordinary_run_length(input);
+
+                for (auto const ch : input.first(run_length))
+                {
+                    *out++ = make_ordinary_key(ch);
+                }
+
+                input = input.subspan(run_length);
+
+                if (input.empty())
+                {
+                    break;
+                }
+            }
+
+            if (auto result = advance(input.front()); result.has_value())
+            {
+                *out++ = std::move(*result);
+            }
+
+            input = input.subspan(1);
+        }
+
+        return out;
+    }
+
 private:
-    enum class state
+    enum class state : std::uint8_t
     {
         idle,
         cr,
@@ -26,25 +113,113 @@ private:
         mouse0,
         mouse1,
         mouse2,
+        paste,
+    };
+
+    // The classes into which input bytes are divided.  Bytes in the same
+    // class cause the same transition from every state.
+    enum class byte_class : std::uint8_t
+    {
+        other,
+        esc,
+        cr,
+        lf,
+        nul,
+        csi8,
+        ss3_8,
+        digit,
+        separator,
+        sub_separator,
+        mouse_tracking,
+        mouse_release,
+        extender,
     };
 
-    std::optional<terminalpp::token> parse_idle(byte input);
-    std::optional<terminalpp::token> parse_cr(byte input);
-    std::optional<terminalpp::token> parse_lf(byte input);
-    std::optional<terminalpp::token> parse_escape(byte input);
-    std::optional<terminalpp::token> parse_arguments(byte input);
-    std::optional<terminalpp::token> parse_mouse0(byte input);
-    std::optional<terminalpp::token> parse_mouse1(byte input);
-    std::optional<terminalpp::token> parse_mouse2(byte input);
+    // The actions that may be performed on a transition.
+    enum class action : std::uint8_t
+    {
+        none,
+        emit_character,
+        emit_enter,
+        begin_escape,
+        begin_csi,
+        begin_ss3,
+        set_meta,
+        set_initializer,
+        append_digit,
+        end_argument,
+        end_sub_argument,
+        set_extender,
+        dispatch_mouse,
+        emit_sequence,
+        set_mouse_event_type,
+        set_mouse_x,
+        emit_mouse_event,
+        reparse_as_idle,
+    };
+
+    struct transition
+    {
+        state next_state;
+        action act;
+    };
+
+    // The constexpr tables that drive the state machine.  These are defined
+    // alongside the actions in the implementation.
+    struct tables;
+
+    // Parses a single byte of input without releasing any pastes.
+    std::optional<terminalpp::token> advance(byte input);
+
+    std::optional<terminalpp::token> perform(action act, byte input);
+    void begin_sequence();
+
+    // Consumes the text of a bracketed paste from the input, returning the
+    // paste token if the end of the paste is found.
+    std::optional<terminalpp::token> parse_paste(bytes &input);
 
+    // Returns the paste token for the text in the paste buffer, which is
+    // retained until the pastes are next released.
+    terminalpp::token complete_buffered_paste();
+
+    // Returns the paste token for the text in a full paste buffer, except
+    // for any bytes at its end that may begin the paste's end marker, which
+    // are kept in the buffer.
+    terminalpp::token complete_partial_paste();
+
+    // Makes the storage of the pastes returned so far available for reuse.
+    void release_pastes() noexcept;
+
+    // Returns the mouse event for an SGR-encoded mouse report.
+    terminalpp::token make_sgr_mouse_event(byte command);
+
+    // Returns the number of bytes at the start of the input that are
+    // ordinary characters when in the idle state.
+    static std::size_t ordinary_run_length(bytes input) noexcept;
+
+    // Returns the token for an ordinary character in the idle state.
+    static terminalpp::token make_ordinary_key(byte input);
+
+    std::size_t max_paste_size_;
     state state_;
     byte initializer_;
     byte extender_;
     bool meta_;
     mouse::event_type mouse_event_type_;
     point mouse_coordinate_;
-    byte_storage argument_;
-    std::vector<byte_storage> arguments_;
+    control_sequence_parameters parameters_;
+
+    // The text of the arguments of the current sequence, including their
+    // separators, which is how the sequence holds them.  Its storage is
+    // reused for each sequence.
+    byte_storage argument_text_;
+    byte_storage paste_buffer_;
+
+    // The text of each paste that spanned more than one input is moved
+    // here when it completes, so that a following paste cannot overwrite
+    // it.  A deque is used since its elements never move as it grows.
+    std::deque<byte_storage> completed_pastes_;
+    std::size_t completed_paste_count_{0};
 };
 
 }  // namespace terminalpp::detail
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "terminalpp/core.hpp"
+#include "terminalpp/element.hpp"
+
+#include <span>
+#include <cstddef>
+
+namespace terminalpp::detail {
+
+//* =========================================================================
+/// \brief The implementations available for finding differences between
+/// rows of elements.
+//* =========================================================================
+enum class row_difference_kernel
+{
+    scalar,
+    sse2,
+    avx2,
+};
+
+//* =========================================================================
+/// \brief Returns true if the kernel can be used on this machine.
+//* =========================================================================
+TERMINALPP_EXPORT
+[[nodiscard]] bool is_supported(row_difference_kernel kernel) noexcept;
+
+//* =========================================================================
+/// \brief Returns the fastest kernel that can be used on this machine.
+//* =========================================================================
+TERMINALPP_EXPORT
+[[nodiscard]] row_difference_kernel select_row_difference_kernel() noexcept;
+
+//* =========================================================================
+/// \brief Returns the index of the first element that differs between the
+/// two rows, or the length of the shorter row if there is no difference.
+///
+/// Whole blocks of elements are compared by their bytes, and only where the
+/// bytes differ are the elements themselves compared.  Equal elements are
+/// almost always byte-for-byte identical (for example, unchanged elements
+/// that were copied from one frame to the next), so this allows the long
+/// unchanged stretches typical of a redrawn screen to be skipped quickly.
+//* =========================================================================
+TERMINALPP_EXPORT
+[[nodiscard]] std::size_t find_first_difference(
+    std::span<element const> lhs, std::span<element const> rhs) noexcept;
+
+//* =========================================================================
+/// \brief As find_first_difference, above, using the given kernel, which
+/// must be supported.
+//* =========================================================================
+TERMINALPP_EXPORT
+[[nodiscard]] std::size_t find_first_difference(
+    row_difference_kernel kernel,
+    std::span<element const> lhs,
+    std::span<element const> rhs) noexcept;
+
+}  // namespace terminalpp::detail
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "terminalpp/compact_token.hpp"
+#include "terminalpp/core.hpp"
+#include "terminalpp/token.hpp"
+
+namespace terminalpp::detail {
+
+//* =========================================================================
+/// \brief Replaces each run of adjacent mouse motion events (that is,
+/// no_button_change events with the same button and modifiers) with the
+/// last event of the run, which holds the latest position.
+//* =========================================================================
+TERMINALPP_EXPORT
+void coalesce_mouse_motion(terminalpp::token_storage &tokens);
+
+//* =========================================================================
+/// \brief Replaces each run of adjacent, identical virtual keys (that is,
+/// keys with the same key, modifiers and input sequence) with a single key
+/// whose repeat count is the sum of theirs.
+//* =========================================================================
+TERMINALPP_EXPORT
+void coalesce_key_repeats(terminalpp::token_storage &tokens);
+
+//* =========================================================================
+/// \brief Merges the token into the last token of the batch, as
+/// coalesce_mouse_motion and coalesce_key_repeats would merge it with the
+/// token before it, for each of them that is enabled.  Returns true if the
+/// token was merged, in which case it should not be added to the batch.
+//* =========================================================================
+TERMINALPP_EXPORT
+bool merge_into_last(
+    token_batch &batch,
+    terminalpp::token const &tok,
+    bool mouse_motion,
+    bool key_repeats);
+
+}  // namespace terminalpp::detail
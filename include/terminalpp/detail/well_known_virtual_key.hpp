@@ -1,17 +1,21 @@
 #pragma once
 
 #include "terminalpp/core.hpp"
+#include "terminalpp/detail/control_sequence_parameters.hpp"
 #include "terminalpp/token.hpp"
 
 namespace terminalpp::detail {
 
 //* =========================================================================
-/// \brief If the token represents a well-known virtual key (e.g. this
-/// particular control sequence is shift-F12), then return a token for the
-/// virtual key.  Otherwise, return the original token.
+/// \brief If the control sequence represents a well-known virtual key (e.g.
+/// this particular control sequence is shift-F12), then return a token for
+/// the virtual key.  Otherwise, return a token for the original sequence.
+///
+/// The parameters are the numeric form of the sequence's arguments, as
+/// accumulated by the parser when it received them.
 //* =========================================================================
 TERMINALPP_EXPORT
 [[nodiscard]] terminalpp::token get_well_known_virtual_key(
-    terminalpp::token const &orig);
+    control_sequence seq, control_sequence_parameters const &parameters);
 
 }  // namespace terminalpp::detail
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "terminalpp/point.hpp"
+#include "terminalpp/virtual_key.hpp"
 
 #include <iosfwd>
 
@@ -17,6 +18,33 @@ enum class event_type : byte
     scrollwheel_down,
 };
 
+//* =========================================================================
+/// \brief The buttons of a mouse.
+//* =========================================================================
+enum class button : byte
+{
+    none,
+    left,
+    middle,
+    right,
+};
+
+//* =========================================================================
+/// \brief The encodings in which a terminal may report mouse events.
+///
+/// The normal encoding transmits each value as a single byte, and so cannot
+/// report positions beyond column or row 223.  The SGR encodings transmit
+/// decimal values, and also report which button was released and the
+/// modifier keys that were held.  With sgr_pixels, positions are reported
+/// in pixels rather than cells.
+//* =========================================================================
+enum class encoding : byte
+{
+    normal,
+    sgr,
+    sgr_pixels,
+};
+
 //* =========================================================================
 /// \brief A structure that encapsulates a mouse event.
 //* =========================================================================
@@ -32,6 +60,20 @@ struct TERMINALPP_EXPORT event
     //* =====================================================================
     point position_;
 
+    //* =====================================================================
+    /// \brief The button that the event concerns, if it is known.  For a
+    /// button_up event, this is the button that was released; for a
+    /// no_button_change event, it is the button held during the motion.
+    /// Only the SGR encodings report this.
+    //* =====================================================================
+    button button_ = button::none;
+
+    //* =====================================================================
+    /// \brief The modifier keys held during the event.  Only the SGR
+    /// encodings report these.
+    //* =====================================================================
+    vk_modifier modifiers_ = vk_modifier::none;
+
     //* =====================================================================
     /// \brief Relational operators for events
     //* =====================================================================
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "terminalpp/core.hpp"
+
+#include <algorithm>
+#include <iosfwd>
+
+namespace terminalpp {
+
+//* =========================================================================
+/// \brief A structure that encapsulates text that was pasted into a
+/// terminal in bracketed paste mode.
+///
+/// \par Usage
+/// When bracketed paste mode is enabled (see enable_bracketed_paste), the
+/// terminal surrounds pasted text with markers, and the whole of the text
+/// is delivered as a single paste token rather than as a token for each
+/// character.
+/// \par
+/// The text is not copied into the token.  Where possible, it refers
+/// directly to the input that was received; when a paste spans more than
+/// one read, it refers to a buffer within the terminal.  Either way, it is
+/// valid only until the terminal reads again, and so must be copied if it
+/// is to be kept beyond the read callback.
+/// \par
+/// A paste that spans more reads than the terminal will buffer is
+/// delivered as several consecutive paste tokens.
+//* =========================================================================
+struct TERMINALPP_EXPORT paste
+{
+    //* =====================================================================
+    /// \brief The text that was pasted, exactly as it was received.
+    //* =====================================================================
+    bytes text;
+
+    //* =====================================================================
+    /// \brief Equality operator for pastes.  Pastes are equal if their text
+    /// is equal, wherever it is held.
+    //* =====================================================================
+    [[nodiscard]] friend bool operator==(
+        paste const &lhs, paste const &rhs) noexcept
+    {
+        return std::ranges::equal(lhs.text, rhs.text);
+    }
+};
+
+//* =========================================================================
+/// \brief Streaming output operator.
+//* =========================================================================
+TERMINALPP_EXPORT
+std::ostream &operator<<(std::ostream &out, paste const &pst);
+
+}  // namespace terminalpp
@@ -1,33 +1,287 @@
 #pragma once
 
 #include "terminalpp/canvas.hpp"
+#include "terminalpp/detail/row_difference.hpp"
 #include "terminalpp/terminal.hpp"
 
+#include <algorithm>
+#include <functional>
+#include <span>
+#include <tuple>
+#include <cstddef>
+
 namespace terminalpp {
 
+//* =========================================================================
+/// \brief The parts of a screen that are independent of its terminal.
+///
+/// This holds the buffers of a screen and its settings.  See basic_screen
+/// for the remainder.
+//* =========================================================================
+class TERMINALPP_EXPORT screen_base
+{
+public:
+    //* =====================================================================
+    /// \brief Returns the back buffer, onto which the next frame may be
+    /// painted before calling present().
+    ///
+    /// The back buffer is initially empty and should be resized to the size
+    /// of the terminal.  Its contents are retained between frames, so only
+    /// the parts of the frame that change need to be repainted.  It tracks
+    /// its dirty regions, so that present() need only compare those.
+    //* =====================================================================
+    [[nodiscard]] canvas &back_buffer();
+
+    //* =====================================================================
+    /// \brief Sets whether frames that are presented while the terminal is
+    /// under backpressure are skipped.  This is disabled by default.
+    //* =====================================================================
+    void set_frame_skipping(bool enabled);
+
+    //* =====================================================================
+    /// \brief Returns whether a skipped frame is waiting to be drawn.
+    //* =====================================================================
+    [[nodiscard]] bool has_pending_frame() const;
+
+protected:
+    //* =====================================================================
+    /// \brief Constructor
+    //* =====================================================================
+    screen_base();
+
+    //* =====================================================================
+    /// \brief Prepares the record of the last frame for drawing the canvas,
+    /// and returns true if it had to be cleared because the size of the
+    /// canvas changed, in which case the whole canvas must be drawn.
+    //* =====================================================================
+    bool begin_frame(canvas const &cvs);
+
+    //* =====================================================================
+    /// \brief Returns true if each element in the gap would be written as
+    /// a single byte after the given previous element, so that the gap can
+    /// be rewritten more cheaply than it can be skipped.
+    //* =====================================================================
+    [[nodiscard]] static bool is_cheap_to_rewrite(
+        element const &previous, std::span<element const> gap);
+
+    canvas back_buffer_{{}};
+    canvas last_frame_{{}};
+    bool frame_pending_{false};
+    bool frame_skipping_{false};
+};
+
 //* =========================================================================
 /// \brief A class that represents a screen for a terminal.
 ///
 /// The screen class implements a double-buffer, whereby each time that a
 /// new canvas is drawn to the terminal, it is compared with the previously
 /// drawn screen so that only differences are sent.
+///
+/// \par Usage
+/// A canvas owned by the application can be passed to draw().
+/// Alternatively, the application can paint onto the screen's own back
+/// buffer and then call present().  In either case, only those elements
+/// that were sent to the terminal are copied into the screen's record of
+/// the previous frame, so drawing a mostly unchanged frame costs no more
+/// than comparing it.
+/// \par Terminals
+/// A basic_screen draws to a terminal of the given type.  For a
+/// basic_terminal of a known channel type, the encoding of the differences
+/// is then inlined all the way to the channel.  Most programs can instead
+/// use terminalpp::screen, which draws to a terminalpp::terminal.
+/// \par Frame Skipping
+/// When frame skipping is enabled, a frame that is presented while the
+/// terminal's channel is under backpressure is not encoded at all.  The
+/// back buffer instead becomes the pending frame, and its dirty regions
+/// accumulate the changes of any further frames that are presented before
+/// draw_pending_frame() is called once the channel has drained.  Since the
+/// record of the previous frame still holds what was last sent, only the
+/// net difference between that and the latest frame is then encoded,
+/// however many frames were skipped in between.  Canvases passed to draw()
+/// are always drawn immediately, and supersede any pending frame.
 //* =========================================================================
-class TERMINALPP_EXPORT screen
+template <typename Terminal>
+class basic_screen final : public screen_base
 {
 public:
+    using terminal_type = Terminal;
+
     //* =====================================================================
     /// \brief Constructor
     //* =====================================================================
-    explicit screen(terminal &term);
+    explicit basic_screen(Terminal &term) : terminal_(term)
+    {
+    }
 
     //* =====================================================================
     /// \brief Draws the canvas to the terminal.
+    ///
+    /// If the canvas tracks dirty regions, then only those regions are
+    /// compared with the previous frame.  In that case, the canvas must
+    /// have been the last one drawn by this screen, and the application
+    /// must call mark_clean() on it after each draw.
+    //* =====================================================================
+    void draw(canvas const &cvs)
+    {
+        draw_frame(cvs);
+    }
+
+    //* =====================================================================
+    /// \brief Draws the back buffer to the terminal, unless the frame is
+    /// skipped (see set_frame_skipping()).
     //* =====================================================================
-    void draw(canvas const &cvs);
+    void present()
+    {
+        // A skipped back buffer keeps its dirty regions, so that they
+        // accumulate until the frame is finally drawn.
+        if (frame_skipping_ && terminal_.is_backpressured())
+        {
+            frame_pending_ = true;
+            return;
+        }
+
+        draw_frame(back_buffer_);
+        back_buffer_.mark_clean();
+    }
+
+    //* =====================================================================
+    /// \brief Draws the most recently skipped frame, if there is one and the
+    /// terminal is no longer under backpressure.
+    //* =====================================================================
+    void draw_pending_frame()
+    {
+        if (frame_pending_)
+        {
+            present();
+        }
+    }
 
 private:
-    terminal &terminal_;
-    canvas last_frame_{{}};
+    //* =====================================================================
+    /// \brief Draws the differences between the canvas and the last frame.
+    //* =====================================================================
+    void draw_frame(canvas const &cvs)
+    {
+        auto const size_changed = begin_frame(cvs);
+
+        if (size_changed)
+        {
+            terminal_ << erase_display();
+        }
+
+        for (coordinate_type row = 0; row < cvs.size().height_; ++row)
+        {
+            auto const [first, last] =
+                size_changed ? canvas::column_range{0, cvs.size().width_}
+                             : cvs.dirty_columns(row);
+
+            if (first == last)
+            {
+                continue;
+            }
+
+            auto const offset = static_cast<std::size_t>(first);
+            auto const length = static_cast<std::size_t>(last - first);
+
+            draw_row(
+                {first, row},
+                cvs.row(row).subspan(offset, length),
+                last_frame_.row(row).subspan(offset, length));
+        }
+
+        terminal_.flush();
+    }
+
+    //* =====================================================================
+    /// \brief Draws a run of changed elements that begins at the origin.
+    //* =====================================================================
+    void draw_run(point const &origin, std::span<element const> run)
+    {
+        // Only the start of a run requires a cursor movement; each
+        // subsequent element is written where the previous one left the
+        // cursor.
+        terminal_ << move_cursor(origin);
+
+        for (auto const &elem : run)
+        {
+            terminal_ << elem;
+        }
+    }
+
+    //* =====================================================================
+    /// \brief Draws the differences between the new and old spans of a row,
+    /// which begin at the given origin, and then copies the changes into
+    /// the old span so that it records what is now on the terminal.
+    //* =====================================================================
+    void draw_row(
+        point const &origin,
+        std::span<element const> new_row,
+        std::span<element> old_row)
+    {
+        auto new_begin = new_row.begin();
+        auto old_begin = old_row.begin();
+
+        for (;;)
+        {
+            // Skip over any unchanged elements to find the start of the next
+            // run of changes.
+            auto const unchanged = static_cast<std::ptrdiff_t>(
+                detail::find_first_difference(
+                    {new_begin, new_row.end()}, {old_begin, old_row.end()}));
+            new_begin += unchanged;
+            old_begin += unchanged;
+
+            if (new_begin == new_row.end())
+            {
+                break;
+            }
+
+            auto [run_end, old_run_end] = std::mismatch(
+                new_begin, new_row.end(), old_begin, std::not_equal_to{});
+
+            // Join this run with any following runs that are separated from
+            // it by only a short gap of unchanged elements.
+            while (run_end != new_row.end())
+            {
+                auto const gap = static_cast<std::ptrdiff_t>(
+                    detail::find_first_difference(
+                        {run_end, new_row.end()},
+                        {old_run_end, old_row.end()}));
+                auto const gap_end = run_end + gap;
+                auto const old_gap_end = old_run_end + gap;
+
+                if (gap_end == new_row.end()
+                    || !is_cheap_to_rewrite(
+                        *(run_end - 1), {run_end, gap_end}))
+                {
+                    break;
+                }
+
+                std::tie(run_end, old_run_end) = std::mismatch(
+                    gap_end, new_row.end(), old_gap_end, std::not_equal_to{});
+            }
+
+            draw_run(
+                {origin.x_
+                     + static_cast<coordinate_type>(
+                         new_begin - new_row.begin()),
+                 origin.y_},
+                {new_begin, run_end});
+            std::copy(new_begin, run_end, old_begin);
+
+            new_begin = run_end;
+            old_begin = old_run_end;
+        }
+    }
+
+    Terminal &terminal_;
 };
 
+//* =========================================================================
+/// \brief A screen that draws to a terminalpp::terminal.
+//* =========================================================================
+using screen = basic_screen<terminal>;
+
+extern template class TERMINALPP_EXPORT basic_screen<terminal>;
+
 }  // namespace terminalpp
@@ -0,0 +1,259 @@
+#pragma once
+
+#include "terminalpp/core.hpp"
+#include "terminalpp/detail/output_queue.hpp"
+
+#include <sys/epoll.h>
+
+#include <array>
+#include <chrono>
+#include <functional>
+#include <span>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace terminalpp {
+
+class socket_channel;
+
+//* =========================================================================
+/// \brief An event loop that dispatches the readiness of socket_channels,
+/// using epoll.
+///
+/// \par Usage
+/// Each socket_channel is registered with a loop when it is constructed.
+/// Calling poll() then waits for any of those channels to become ready and
+/// performs their reads and writes, calling their read callbacks as data
+/// arrives.
+//* =========================================================================
+class TERMINALPP_EXPORT epoll_loop
+{
+public:
+    static constexpr std::size_t max_events = 64;
+
+    //* =====================================================================
+    /// \brief Constructor
+    /// \throws std::system_error if the epoll instance cannot be created.
+    //* =====================================================================
+    epoll_loop();
+
+    //* =====================================================================
+    /// \brief Copy Constructor
+    //* =====================================================================
+    epoll_loop(epoll_loop const &) = delete;
+
+    //* =====================================================================
+    /// \brief Destructor
+    //* =====================================================================
+    ~epoll_loop();
+
+    //* =====================================================================
+    /// \brief Copy Assignment
+    //* =====================================================================
+    epoll_loop &operator=(epoll_loop const &) = delete;
+
+    //* =====================================================================
+    /// \brief Waits up to the given timeout for any registered channel to
+    /// become ready, and then services each ready channel.  A negative
+    /// timeout waits indefinitely.
+    /// \returns the number of channels that were serviced.
+    //* =====================================================================
+    std::size_t poll(
+        std::chrono::milliseconds timeout = std::chrono::milliseconds{0});
+
+private:
+    friend class socket_channel;
+
+    //* =====================================================================
+    /// \brief Registers a channel's descriptor with the loop.
+    /// \throws std::system_error if the descriptor cannot be registered.
+    //* =====================================================================
+    void add(int fd, socket_channel *channel);
+
+    //* =====================================================================
+    /// \brief Changes the events in which a channel is interested.
+    //* =====================================================================
+    void modify(int fd, socket_channel *channel, std::uint32_t events);
+
+    //* =====================================================================
+    /// \brief Deregisters a channel, including from any events that have
+    /// been received but not yet dispatched.
+    //* =====================================================================
+    void remove(int fd, socket_channel *channel);
+
+    int epoll_fd_;
+    std::vector<epoll_event> events_;
+    std::size_t received_{0};
+};
+
+//* =========================================================================
+/// \brief The limits on the output that a socket_channel may queue.
+//* =========================================================================
+struct output_watermarks
+{
+    /// Once the queue has reached the high watermark, the channel reports
+    /// that it is under backpressure.
+    std::size_t high = 64 * 1024;
+
+    /// Once the queue has drained to the low watermark, the channel reports
+    /// that it is no longer under backpressure.
+    std::size_t low = 16 * 1024;
+
+    /// A client that lets the queue grow beyond its capacity is considered
+    /// lost, and the channel is closed.
+    std::size_t capacity = 1024 * 1024;
+};
+
+//* =========================================================================
+/// \brief A class that models the terminal's channel concept over a
+/// connected stream socket (for example, a TCP or Unix domain socket).
+///
+/// \par Usage
+/// The channel takes ownership of the socket, makes it non-blocking and
+/// registers it with an epoll_loop, which performs its reads and writes.
+/// \par
+/// Output that the socket will not accept is queued.  The queue is bounded
+/// by the output_watermarks: when it grows past the high watermark, the
+/// channel is under backpressure until it drains back to the low watermark,
+/// which allows the writer to skip or merge output for a slow client.  If
+/// the queue would grow beyond its capacity regardless, then the channel is
+/// closed, rather than allowing the memory used by the client to grow
+/// without limit.
+//* =========================================================================
+class TERMINALPP_EXPORT socket_channel
+{
+public:
+    using read_callback = std::function<void(terminalpp::bytes)>;
+    using backpressure_callback = std::function<void(bool)>;
+
+    static constexpr std::size_t read_buffer_size = 4096;
+
+    //* =====================================================================
+    /// \brief Constructor
+    /// \throws std::system_error if the socket cannot be made non-blocking
+    /// or registered with the loop, in which case the caller retains
+    /// ownership of it.
+    //* =====================================================================
+    socket_channel(
+        epoll_loop &loop, int fd, output_watermarks watermarks = {});
+
+    //* =====================================================================
+    /// \brief Copy Constructor
+    //* =====================================================================
+    socket_channel(socket_channel const &) = delete;
+
+    //* =====================================================================
+    /// \brief Destructor.  Closes the socket.
+    //* =====================================================================
+    ~socket_channel();
+
+    //* =====================================================================
+    /// \brief Copy Assignment
+    //* =====================================================================
+    socket_channel &operator=(socket_channel const &) = delete;
+
+    //* =====================================================================
+    /// \brief Request data from the channel.
+    ///
+    /// The callback is called from the loop when data is available.  If the
+    /// channel dies, then the callback is called with no data.
+    //* =====================================================================
+    void async_read(read_callback const &callback);
+
+    //* =====================================================================
+    /// \brief Writes the data to the socket.
+    ///
+    /// Any data that cannot be written without blocking is queued.
+    //* =====================================================================
+    void write(terminalpp::bytes data);
+
+    //* =====================================================================
+    /// \brief Writes the fragments to the output, in order, with a single
+    /// gathering write.
+    ///
+    /// Any data that cannot be written without blocking is queued.
+    //* =====================================================================
+    void write(std::span<terminalpp::bytes const> data);
+
+    //* =====================================================================
+    /// \brief Returns whether the channel is alive.
+    //* =====================================================================
+    [[nodiscard]] bool is_alive() const;
+
+    //* =====================================================================
+    /// \brief Closes the channel.
+    ///
+    /// Any queued output that the socket will accept without blocking is
+    /// sent first; the remainder is discarded.
+    //* =====================================================================
+    void close();
+
+    //* =====================================================================
+    /// \brief Returns whether the channel is under backpressure; that is,
+    /// whether the client is failing to keep up with the output.
+    //* =====================================================================
+    [[nodiscard]] bool is_backpressured() const;
+
+    //* =====================================================================
+    /// \brief Sets a function to be called whenever the channel enters or
+    /// leaves backpressure.
+    //* =====================================================================
+    void on_backpressure(backpressure_callback const &callback);
+
+    //* =====================================================================
+    /// \brief Returns the number of bytes that are queued for output.
+    //* =====================================================================
+    [[nodiscard]] std::size_t pending() const;
+
+private:
+    friend class epoll_loop;
+
+    //* =====================================================================
+    /// \brief Services the events that the loop received for the socket.
+    //* =====================================================================
+    void handle_events(std::uint32_t events);
+
+    //* =====================================================================
+    /// \brief Reads any available input and dispatches it to the read
+    /// callback.
+    //* =====================================================================
+    void read_input();
+
+    //* =====================================================================
+    /// \brief Writes as much of the queue as possible without blocking.
+    /// \returns false if the socket failed, in which case the channel has
+    /// died, and may have been destroyed by its read callback.
+    //* =====================================================================
+    bool write_queue();
+
+    //* =====================================================================
+    /// \brief Updates the backpressure state after the queue has changed.
+    //* =====================================================================
+    void update_backpressure();
+
+    //* =====================================================================
+    /// \brief Updates the events in which the channel is interested in the
+    /// loop after its state has changed.
+    //* =====================================================================
+    void update_interest();
+
+    //* =====================================================================
+    /// \brief Closes the socket, relieves any backpressure and calls back
+    /// any outstanding read with no data.  Either callback may destroy the
+    /// channel, and so it must not be used afterwards.
+    //* =====================================================================
+    void die();
+
+    epoll_loop &loop_;
+    int fd_;
+    output_watermarks watermarks_;
+    read_callback read_callback_;
+    backpressure_callback backpressure_callback_;
+    detail::output_queue queue_;
+    std::array<byte, read_buffer_size> read_buffer_;
+    std::uint32_t interest_{0};
+    bool backpressured_{false};
+};
+
+}  // namespace terminalpp
@@ -2,42 +2,229 @@
 
 #include "terminalpp/core.hpp"
 
+#ifndef _WIN32
+#include "terminalpp/detail/output_queue.hpp"
+#endif
+
+#include <chrono>
 #include <functional>
+#include <memory>
+#include <span>
+#include <cstddef>
 
 namespace terminalpp {
 
 //* =========================================================================
-/// \brief A class that models the terminal's channel concept, providing
-/// output to stdout.
+/// \brief A class that models the terminal's channel concept over a pair
+/// of POSIX file descriptors, by default stdin and stdout.
+///
+/// \par Usage
+/// Both descriptors are placed into non-blocking mode for the lifetime of
+/// the channel, and restored when it is destroyed.  Writes are sent
+/// immediately if possible; whatever the descriptor does not accept is
+/// queued, and the queue is later sent in a single gathering write.
+/// \par
+/// Reading is not driven by a thread.  Instead, after a read has been
+/// requested with async_read, a call to poll() waits for input and
+/// dispatches it to the read callback.  poll() also sends any queued
+/// output as the descriptor becomes writable.  Programs that never read
+/// need not call poll() at all, since any queued output is flushed when
+/// the channel is destroyed.
+/// \par Windows
+/// On Windows, the channel is a simple blocking writer.  Each write is sent
+/// in full before it returns, so that nothing is ever queued, and no input
+/// is read: a requested read is only called back when the channel is
+/// closed.
 //* =========================================================================
-class stdout_channel
+class TERMINALPP_EXPORT stdout_channel
 {
 public:
+    using read_callback = std::function<void(terminalpp::bytes)>;
+
+    static constexpr std::size_t read_buffer_size = 4096;
+
+    //* =====================================================================
+    /// \brief Constructs a channel that reads from stdin and writes to
+    /// stdout.
+    //* =====================================================================
+    stdout_channel();
+
+    //* =====================================================================
+    /// \brief Constructs a channel that reads from and writes to the given
+    /// file descriptors.  The descriptors are not owned by the channel.
+    //* =====================================================================
+    stdout_channel(int input_fd, int output_fd);
+
+    //* =====================================================================
+    /// \brief Copy Constructor
+    //* =====================================================================
+    stdout_channel(stdout_channel const &) = delete;
+
+    //* =====================================================================
+    /// \brief Destructor
+    ///
+    /// Flushes any queued output and restores the original modes of the
+    /// file descriptors.
+    //* =====================================================================
+    ~stdout_channel();
+
+    //* =====================================================================
+    /// \brief Copy Assignment
+    //* =====================================================================
+    stdout_channel &operator=(stdout_channel const &) = delete;
+
     //* =====================================================================
     /// \brief Request data from the channel.
     ///
-    /// A stdout channel does no inputting, so this is silently discarded.
+    /// The callback is called from a subsequent call to poll() when data is
+    /// available.  If the input reaches its end, then the callback is
+    /// called with no data and the channel is no longer alive.  If the
+    /// channel is already dead, then the callback is called immediately
+    /// with no data.
     //* =====================================================================
-    void async_read(std::function<void(terminalpp::bytes)> const &);
+    void async_read(read_callback const &callback);
 
     //* =====================================================================
-    /// \brief Writes the data to stdout.
+    /// \brief Writes the data to the output.
+    ///
+    /// Any data that cannot be written without blocking is queued.
     //* =====================================================================
     void write(terminalpp::bytes data);
 
     //* =====================================================================
-    /// \brief Returns whether the output stream is alive.
+    /// \brief Writes the fragments to the output, in order, with a single
+    /// gathering write.
     ///
-    /// For simplicity, a stdout channel is always alive.
+    /// Any data that cannot be written without blocking is queued.
+    //* =====================================================================
+    void write(std::span<terminalpp::bytes const> data);
+
+    //* =====================================================================
+    /// \brief Returns whether the channel is alive.
+    ///
+    /// A channel dies when it is closed, when its input reaches its end, or
+    /// when an error occurs on either of its descriptors.
     //* =====================================================================
     [[nodiscard]] bool is_alive() const;
 
     //* =====================================================================
-    /// \brief Requests that the channel be closed.
+    /// \brief Closes the channel.
     ///
-    /// For simplicity, a stdout channel cannot be closed, so this is a no-op.
+    /// Queued output is flushed, and any outstanding read is called back
+    /// with no data.  The descriptors themselves are not closed.
     //* =====================================================================
     void close();
+
+    //* =====================================================================
+    /// \brief Waits up to the given timeout for the channel to become ready,
+    /// then dispatches any input to the outstanding read and sends any
+    /// queued output that the descriptor will now accept.
+    /// \returns true if any input was dispatched or output was sent.
+    //* =====================================================================
+    bool poll(std::chrono::milliseconds timeout = std::chrono::milliseconds{0});
+
+    //* =====================================================================
+    /// \brief Blocks until all queued output has been written, or the
+    /// channel has died.
+    //* =====================================================================
+    void flush();
+
+    //* =====================================================================
+    /// \brief Returns whether the channel is under backpressure, which is
+    /// whenever there is queued output.
+    //* =====================================================================
+    [[nodiscard]] bool is_backpressured() const;
+
+    //* =====================================================================
+    /// \brief Returns the number of bytes that are queued for output.
+    //* =====================================================================
+    [[nodiscard]] std::size_t pending() const;
+
+private:
+#ifndef _WIN32
+    //* =====================================================================
+    /// \brief Reads any available input and dispatches it to the read
+    /// callback.  Returns true if the callback was called.
+    //* =====================================================================
+    bool read_input();
+
+    //* =====================================================================
+    /// \brief Writes as much of the queue as possible without blocking.
+    /// Returns true if any bytes were written.
+    //* =====================================================================
+    bool write_queue();
+
+    //* =====================================================================
+    /// \brief Marks the channel as dead and calls back any outstanding read
+    /// with no data.
+    //* =====================================================================
+    void die();
+
+    int input_fd_;
+    int output_fd_;
+    int input_flags_;
+    int output_flags_;
+    read_callback read_callback_;
+    detail::output_queue queue_;
+    bool alive_{true};
+#else
+    int output_fd_;
+    read_callback read_callback_;
+    bool alive_{true};
+#endif
+};
+
+//* =========================================================================
+/// \brief Places a tty into raw mode for the lifetime of the object.
+///
+/// \par Usage
+/// In raw mode, input is delivered byte-by-byte as it is typed, without
+/// being echoed and without the tty interpreting line editing or signal
+/// keys, which is what an application reading tokens from a terminal
+/// requires.  Output processing is left untouched so that newlines written
+/// to the terminal still return the cursor to the start of the line.
+/// \par
+/// If the descriptor is not a tty (for example, if input is redirected from
+/// a file), then this does nothing.
+//* =========================================================================
+class TERMINALPP_EXPORT raw_mode
+{
+public:
+    //* =====================================================================
+    /// \brief Constructs a raw_mode for stdin.
+    //* =====================================================================
+    raw_mode();
+
+    //* =====================================================================
+    /// \brief Constructs a raw_mode for the given file descriptor.
+    //* =====================================================================
+    explicit raw_mode(int fd);
+
+    //* =====================================================================
+    /// \brief Copy Constructor
+    //* =====================================================================
+    raw_mode(raw_mode const &) = delete;
+
+    //* =====================================================================
+    /// \brief Destructor.  Restores the tty's original mode.
+    //* =====================================================================
+    ~raw_mode();
+
+    //* =====================================================================
+    /// \brief Copy Assignment
+    //* =====================================================================
+    raw_mode &operator=(raw_mode const &) = delete;
+
+    //* =====================================================================
+    /// \brief Returns whether the tty was placed into raw mode.
+    //* =====================================================================
+    [[nodiscard]] bool is_active() const;
+
+private:
+    struct saved_mode;
+
+    int fd_;
+    std::unique_ptr<saved_mode> saved_mode_;
 };
 
 }  // namespace terminalpp
@@ -1,89 +1,397 @@
 #pragma once
 
+#include "terminalpp/any_channel.hpp"
 #include "terminalpp/behaviour.hpp"
+#include "terminalpp/compact_token.hpp"
 #include "terminalpp/core.hpp"
+#include "terminalpp/detail/cursor_movement.hpp"
+#include "terminalpp/detail/element_writing.hpp"
+#include "terminalpp/detail/overloaded.hpp"
 #include "terminalpp/string.hpp"
 #include "terminalpp/terminal_state.hpp"
 #include "terminalpp/token.hpp"
+#include "terminalpp/write_continuation.hpp"
 
 #include <concepts>  // IWYU pragma: keep
 #include <functional>
+#include <memory>
+#include <span>
+#include <type_traits>
 #include <utility>
+#include <vector>
+#include <cstddef>
 
 namespace terminalpp {
 
 template <typename Manipulator>
 concept terminal_manipulator =
-    requires(Manipulator manipulator, terminal_state state) {
+    requires(
+        Manipulator manipulator,
+        terminal_state state,
+        write_continuation write_fn) {
         {
-            manipulator(
-                terminalpp::behaviour{}, state, std::function<void(bytes)>{})
+            manipulator(terminalpp::behaviour{}, state, write_fn)
         } -> std::same_as<void>;
     };
 
 //* =========================================================================
-/// \brief A class that encapsulates a terminal.
+/// \brief The parts of a terminal that are independent of its channel.
 ///
-/// A class that is used to stream data in and out of a terminal.
+/// This holds the state of a terminal and the settings that affect how it
+/// encodes output and parses input.  See basic_terminal for the remainder.
 //* =========================================================================
-class TERMINALPP_EXPORT terminal final
+class TERMINALPP_EXPORT terminal_base
 {
 public:
     using read_function = std::function<void(terminalpp::tokens)>;
     using write_function = std::function<void(terminalpp::bytes)>;
 
     //* =====================================================================
-    /// \brief Constructor.
+    /// \brief Copy Constructor
+    //* =====================================================================
+    terminal_base(terminal_base const &) = delete;
+
+    //* =====================================================================
+    /// \brief Copy Assignment
+    //* =====================================================================
+    terminal_base &operator=(terminal_base const &) = delete;
+
+    //* =====================================================================
+    /// \brief Sets a cache in which the encodings of attribute changes are
+    /// stored, so that repeated transitions need not be re-encoded.
+    ///
+    /// The cache may be shared between terminals that have the same
+    /// behaviour.  Passing nullptr disables caching, which is the default.
+    //* =====================================================================
+    void set_attribute_transition_cache(
+        std::shared_ptr<attribute_transition_cache> cache);
+
     //* =====================================================================
-    template <typename Channel>
-    explicit terminal(Channel &channel, behaviour beh = behaviour{})
-      : channel_{std::unique_ptr<channel_concept>{
-          std::make_unique<channel_model<Channel>>(channel)}},
-        behaviour_(std::move(beh))
+    /// \brief Sets whether adjacent mouse motion events that are read in
+    /// the same block of input are coalesced into the last of them.
+    ///
+    /// With all-motion mouse tracking, a terminal reports every cell that
+    /// the mouse crosses, though usually only the latest position is of
+    /// interest.  When coalescing is enabled, which is not the default,
+    /// each run of motion events is delivered as a single event.
+    //* =====================================================================
+    void set_mouse_motion_coalescing(bool enabled);
+
+    //* =====================================================================
+    /// \brief Sets whether adjacent, identical virtual keys that are read
+    /// in the same block of input are coalesced into one.
+    ///
+    /// A key that is held down is reported once per repeat.  When
+    /// coalescing is enabled, which is not the default, each run of such
+    /// keys is delivered as a single key whose repeat_count is the number
+    /// of times it was repeated.
+    //* =====================================================================
+    void set_key_repeat_coalescing(bool enabled);
+
+    //* =====================================================================
+    /// \brief Sets the size of the terminal.
+    /// This is used to determine cursor locations when writing text that
+    /// wraps at the end of the line, etc.
+    //* =====================================================================
+    void set_size(extent size);
+
+protected:
+    //* =====================================================================
+    /// \brief Constructor
+    //* =====================================================================
+    explicit terminal_base(behaviour beh);
+
+    //* =====================================================================
+    /// \brief Destructor
+    //* =====================================================================
+    ~terminal_base();
+
+    //* =====================================================================
+    /// \brief Parses the data into tokens, replacing the contents of
+    /// results.
+    //* =====================================================================
+    void tokenize(bytes data, token_storage &results);
+
+    //* =====================================================================
+    /// \brief Parses the data into compact tokens, replacing the contents
+    /// of batch.  Each token is compacted as soon as it is parsed, so the
+    /// full tokens are never stored.
+    //* =====================================================================
+    void tokenize(bytes data, token_batch &batch);
+
+    //* =====================================================================
+    /// \brief Writes the output of the manipulator into the output buffer.
+    ///
+    /// The manipulator is passed a function object of its own type, rather
+    /// than a write_function, so that manipulators which accept any write
+    /// function can have their output inlined into the buffer.
+    //* =====================================================================
+    void buffer_manipulator(terminal_manipulator auto &&manip)
     {
+        manip(
+            behaviour_,
+            state_,
+            detail::overloaded{
+                [this](bytes data) {
+                    output_buffer_.append(data.begin(), data.end());
+                },
+                [this](static_bytes data) { buffer_static(data.data); }});
     }
 
     //* =====================================================================
-    /// \brief Copy Constructor
+    /// \brief Buffers data that has static storage duration.
+    ///
+    /// If the channel supports gathering writes and the data is large
+    /// enough, then it is referred to, rather than copied, and is sent as a
+    /// fragment of its own when the output is flushed.  Only a limited
+    /// number of fragments are held in this way, so that a long run of
+    /// output is still sent in few pieces; beyond that, for smaller data,
+    /// and for other channels, the data is copied into the output buffer.
     //* =====================================================================
-    terminal(terminal const &) = delete;
+    void buffer_static(bytes data);
 
     //* =====================================================================
-    /// \brief Destructor.
+    /// \brief Discards the buffered output, retaining the capacity of the
+    /// buffers so that subsequent output does not need to allocate.
     //* =====================================================================
-    ~terminal();
+    void clear_output();
 
     //* =====================================================================
-    /// \brief Copy Assignment
+    /// \brief Returns the size of the buffered output together with that
+    /// of the fragments.
     //* =====================================================================
-    terminal &operator=(terminal const &) = delete;
+    [[nodiscard]] std::size_t output_size(
+        std::span<bytes const> fragments) const;
+
+    //* =====================================================================
+    /// \brief Appends the fragments to the output buffer.
+    //* =====================================================================
+    void buffer_fragments(std::span<bytes const> fragments);
+
+    //* =====================================================================
+    /// \brief Collects the buffered output and the non-empty fragments into
+    /// the list of output fragments, in order, and returns it.
+    //* =====================================================================
+    [[nodiscard]] std::span<bytes const> collect_fragments(
+        std::span<bytes const> fragments);
+
+    //* =====================================================================
+    /// \brief Static data that is to be sent at the given offset in the
+    /// output buffer.
+    //* =====================================================================
+    struct static_fragment
+    {
+        std::size_t offset_;
+        bytes data_;
+    };
+
+    // The most static fragments that are held before static data is copied
+    // into the output buffer instead.  This is well below the number of
+    // fragments that a channel sends in one gathering write.
+    static constexpr std::size_t max_static_fragments = 16;
+
+    // The smallest static data that is held as a fragment.  Copying a few
+    // bytes is cheaper than describing them as a fragment of their own, so
+    // the constant escape sequences, which are all far shorter than this,
+    // are copied, and only large blocks of static data are referred to.
+    static constexpr std::size_t min_static_fragment_size = 32;
+
+    behaviour behaviour_;
+    terminal_state state_;
+    byte_storage output_buffer_;
+    std::vector<static_fragment> static_fragments_;
+    std::size_t static_output_size_{0};
+    std::vector<bytes> output_fragments_;
+    byte_storage gathered_output_;
+    token_storage input_tokens_;
+    token_batch input_batch_;
+    std::size_t flush_threshold_{0};
+    bool coalesce_mouse_motion_{false};
+    bool coalesce_key_repeats_{false};
+    bool gather_static_output_{false};
+};
+
+//* =========================================================================
+/// \brief A class that encapsulates a terminal.
+///
+/// A class that is used to stream data in and out of a terminal.
+///
+/// \par Channels
+/// A basic_terminal sends its output to, and reads its input from, a
+/// channel of the given type (see any_channel for the requirements of a
+/// channel).  When the type of the channel is known at compile time, then
+/// the terminal calls it directly, without any virtual dispatch, so that
+/// the path from encoding output to sending it can be inlined.  Most
+/// programs can instead use terminalpp::terminal, which can be constructed
+/// with a channel of any type.
+//* =========================================================================
+template <typename Channel>
+class basic_terminal final : public terminal_base
+{
+public:
+    using channel_type = Channel;
+
+    //* =====================================================================
+    /// \brief Constructor.
+    //* =====================================================================
+    template <typename ChannelRef>
+    explicit basic_terminal(ChannelRef &channel, behaviour beh = behaviour{})
+      : terminal_base(std::move(beh)), channel_(channel)
+    {
+        gather_static_output_ = detail::supports_gathering(channel_);
+    }
 
     //* =====================================================================
     /// \brief Request that data be read from the terminal.
     //* =====================================================================
-    void async_read(std::function<void(tokens)> const &callback);
+    void async_read(std::function<void(tokens)> const &callback)
+    {
+        channel_.async_read([this, callback](terminalpp::bytes data) {
+            // The token buffer is reused from read to read so that, once it
+            // has grown to fit the usual amount of input, no allocation
+            // takes place.  It is taken out of the terminal for the
+            // duration of the callback in case the callback causes a nested
+            // read.
+            auto results = std::move(input_tokens_);
+            tokenize(data, results);
+
+            callback(results);
+            input_tokens_ = std::move(results);
+        });
+    }
+
+    //* =====================================================================
+    /// \brief Request that data be read from the terminal, with the tokens
+    /// delivered in compact form.
+    ///
+    /// The tokens are the same as those that async_read would deliver, but
+    /// are held in a token_batch, which is much smaller and so faster to
+    /// iterate over.  The batch is valid only for the duration of the
+    /// callback.
+    //* =====================================================================
+    void async_read_compact(
+        std::function<void(token_batch const &)> const &callback)
+    {
+        channel_.async_read([this, callback](terminalpp::bytes data) {
+            // As with async_read, the batch is reused from read to read and
+            // is taken out of the terminal for the duration of the callback.
+            auto batch = std::move(input_batch_);
+            tokenize(data, batch);
+
+            callback(batch);
+            input_batch_ = std::move(batch);
+        });
+    }
 
     //* =====================================================================
     /// \brief Write data to the terminal.
+    ///
+    /// The data is appended to the terminal's output buffer, which is then
+    /// flushed to the channel if it has reached the flush threshold.
+    //* =====================================================================
+    void write(bytes data)
+    {
+        write(std::span{&data, 1});
+    }
+
     //* =====================================================================
-    void write(bytes data);
+    /// \brief Write a sequence of fragments to the terminal.
+    ///
+    /// The fragments are treated as if they were written one after the
+    /// other.  If, together with the output buffer, they reach the flush
+    /// threshold, then they are handed to the channel after the buffer
+    /// without first being copied into it.  If the channel has a
+    /// write(std::span<bytes const>) member function, then they are passed
+    /// to it directly, which allows (for example) constant escape sequences
+    /// to be sent with a single gathering write, with no copying at all.
+    /// Otherwise, they are concatenated into a single write.  Fragments that
+    /// do not reach the threshold are copied into the output buffer.
+    /// \par
+    /// The output of manipulators, including the built-in ones and the
+    /// streaming of elements and strings, is encoded into the output buffer,
+    /// since much of it is assembled in temporary storage.  Large blocks of
+    /// static data that they write as static_bytes are the exception: if
+    /// the channel supports gathering writes, then these are referred to,
+    /// rather than copied, and sent as fragments in the same way.
+    //* =====================================================================
+    void write(std::span<bytes const> fragments)
+    {
+        if (output_size(fragments) < flush_threshold_)
+        {
+            buffer_fragments(fragments);
+            return;
+        }
+
+        if (auto const output = collect_fragments(fragments); !output.empty())
+        {
+            detail::write_fragments(channel_, output, gathered_output_);
+        }
+
+        clear_output();
+    }
+
+    //* =====================================================================
+    /// \brief Writes any buffered output to the channel as a single block.
+    //* =====================================================================
+    void flush()
+    {
+        if (!static_fragments_.empty())
+        {
+            detail::write_fragments(
+                channel_, collect_fragments({}), gathered_output_);
+            clear_output();
+        }
+        else if (!output_buffer_.empty())
+        {
+            channel_.write(bytes{output_buffer_});
+            clear_output();
+        }
+    }
+
+    //* =====================================================================
+    /// \brief Sets the number of bytes that may be held in the output buffer
+    /// before it is automatically flushed to the channel.
+    ///
+    /// By default, this is 0, meaning that the output of each write or
+    /// streaming operation is sent to the channel immediately in one write.
+    /// Raising it allows, for example, a whole screen update to be sent as
+    /// one block by following it with a call to flush().  Note that any
+    /// output remaining in the buffer when the terminal is destroyed is
+    /// discarded.
+    //* =====================================================================
+    void set_flush_threshold(std::size_t threshold)
+    {
+        flush_threshold_ = threshold;
+        flush_if_over_threshold();
+    }
 
     //* =====================================================================
     /// \brief Returns whether the terminal is alive or not.
     //* =====================================================================
-    [[nodiscard]] bool is_alive() const;
+    [[nodiscard]] bool is_alive() const
+    {
+        return channel_.is_alive();
+    }
 
     //* =====================================================================
     /// Closes the terminal.
     //* =====================================================================
-    void close();
+    void close()
+    {
+        channel_.close();
+    }
 
     //* =====================================================================
-    /// \brief Sets the size of the terminal.
-    /// This is used to determine cursor locations when writing text that
-    /// wraps at the end of the line, etc.
+    /// \brief Returns whether the channel is under backpressure; that is,
+    /// whether output is being written faster than it can be sent.
+    ///
+    /// A channel reports this with an is_backpressured() member function.
+    /// Channels without one are never considered to be under backpressure.
     //* =====================================================================
-    void set_size(extent size);
+    [[nodiscard]] bool is_backpressured() const
+    {
+        return detail::is_backpressured(channel_);
+    }
 
     //* =====================================================================
     /// \brief Write to the terminal.
@@ -105,135 +413,55 @@ public:
     /// void operator()(
     ///     terminalpp::behaviour const &beh,
     ///     terminalpp::terminal_state &state,
-    ///     terminalpp::terminal::write_function const &write_fn) const;
+    ///     terminalpp::write_continuation write_fn) const;
     /// \endcode
+    /// The write function may also be taken as a
+    /// terminalpp::terminal::write_function, at the cost of converting to a
+    /// std::function on each call, or as a template parameter, in which case
+    /// the manipulator's output can be inlined into the terminal's buffer.
     //* =====================================================================
-    terminal &operator<<(terminal_manipulator auto &&manip)
+    basic_terminal &operator<<(terminal_manipulator auto &&manip)
     {
-        manip(behaviour_, state_, [this](bytes data) { write(data); });
+        buffer_manipulator(manip);
+        flush_if_over_threshold();
         return *this;
     }
 
     //* =====================================================================
     /// \brief Write a single element to the terminal
     //* =====================================================================
-    terminal &operator<<(terminalpp::element const &elem);
+    basic_terminal &operator<<(terminalpp::element const &elem);
 
     //* =====================================================================
     /// \brief Write an attributed string to the terminal.
     //* =====================================================================
-    terminal &operator<<(terminalpp::string const &text);
-
-    //* =====================================================================
-    /// \brief Read from the terminal.
-    ///
-    /// \par Usage
-    /// Stream in bytes, and the resultant tokens parsed from the stream will
-    /// be sent to the write function.
-    /// \code
-    /// using namespace terminalpp::literals;
-    /// void raw_read(terminalpp::tokens);
-    /// void raw_write(terminalpp::bytes);
-    /// terminal term{raw_read, raw_write};
-    /// term >> "\\x1B[13~"_tb;
-    /// // read_tokens was called with a collection of one token, which
-    /// // contained the f3 virtual key.
-    /// \endcode
-    //* =====================================================================
-    // terminal &operator>>(terminalpp::bytes data);
+    basic_terminal &operator<<(terminalpp::string const &text);
 
 private:
     //* =====================================================================
-    /// \brief Constructor
-    //* =====================================================================
-    explicit terminal(behaviour beh);
-
-    //* =====================================================================
-    /// \brief An interface for a channel model.
-    //* =====================================================================
-    struct channel_concept
-    {
-        //* =================================================================
-        /// \brief Destructor
-        //* =================================================================
-        virtual ~channel_concept() = default;
-
-        //* =================================================================
-        /// \brief Asynchronously read from the channel and call the function
-        /// back when it's available.
-        //* =================================================================
-        virtual void async_read(std::function<void(bytes)> const &) = 0;
-
-        //* =================================================================
-        /// \brief Write the given data to the channel.
-        //* =================================================================
-        virtual void write(bytes data) = 0;
-
-        //* =================================================================
-        /// \brief Returns whether the channel is alive.
-        //* =================================================================
-        [[nodiscard]] virtual bool is_alive() const = 0;
-
-        //* =================================================================
-        /// \brief Closes the channel.
-        //* =================================================================
-        virtual void close() = 0;
-    };
-
-    //* =====================================================================
-    /// \brief An implementation of the channel model.
+    /// \brief Flushes the output buffer if it has reached the threshold.
     //* =====================================================================
-    template <typename Channel>
-    struct channel_model final : channel_concept
+    void flush_if_over_threshold()
     {
-        //* =================================================================
-        /// \brief Constructor
-        //* =================================================================
-        explicit channel_model(Channel &channel) : channel_(channel)
-        {
-        }
-
-        //* =================================================================
-        /// \brief Asynchronously read from the channel and call the function
-        /// back when it's available.
-        //* =================================================================
-        void async_read(std::function<void(bytes)> const &callback) override
-        {
-            channel_.async_read(callback);
-        }
-
-        //* =================================================================
-        /// \brief Write the given data to the channel.
-        //* =================================================================
-        void write(bytes data) override
+        if (output_size({}) >= flush_threshold_)
         {
-            channel_.write(data);
+            flush();
         }
+    }
 
-        //* =================================================================
-        /// \brief Returns whether the channel is alive.
-        //* =================================================================
-        [[nodiscard]] bool is_alive() const override
-        {
-            return channel_.is_alive();
-        }
-
-        //* =================================================================
-        /// \brief Closes the channel.
-        //* =================================================================
-        void close() override
-        {
-            channel_.close();
-        }
-
-        Channel &channel_;
-    };
-
-    std::unique_ptr<channel_concept> channel_;
-    behaviour behaviour_;
-    terminal_state state_;
+    // A type-erased channel is held by value; any other is referred to.
+    std::conditional_t<
+        std::is_same_v<Channel, any_channel>,
+        any_channel,
+        Channel &>
+        channel_;
 };
 
+//* =========================================================================
+/// \brief A terminal that may be used with a channel of any type.
+//* =========================================================================
+using terminal = basic_terminal<any_channel>;
+
 //* =========================================================================
 /// \brief A manipulator that converts encoded attribute strings into ANSI
 /// protocol bytes.
@@ -252,10 +480,14 @@ public:
     //* =====================================================================
     /// \brief Convert the text and write the result to the write function
     //* =====================================================================
+    template <class WriteContinuation>
     void operator()(
         terminalpp::behaviour const &beh,
         terminalpp::terminal_state &state,
-        terminal::write_function const &write_fn) const;
+        WriteContinuation &&wc) const
+    {
+        detail::write_element(element_, beh, state, wc);
+    }
 
 private:
     terminalpp::element element_;
@@ -273,10 +505,14 @@ struct TERMINALPP_EXPORT write_optional_default_attribute
     //* =====================================================================
     /// \brief Writes the default attribute to the terminal if necessary.
     //* =====================================================================
+    template <class WriteContinuation>
     void operator()(
         terminalpp::behaviour const &beh,
         terminalpp::terminal_state &state,
-        terminal::write_function const &write_fn) const;
+        WriteContinuation &&wc) const
+    {
+        detail::write_optional_default_attribute(beh, state, wc);
+    }
 };
 
 //* =========================================================================
@@ -296,12 +532,17 @@ public:
 
     //* =====================================================================
     /// \brief Writes the ANSI protocol codes necessary to move the cursor to
-    /// the initialized location to write_fn.
+    /// the initialized location to the write continuation.
     //* =====================================================================
+    template <class WriteContinuation>
     void operator()(
         terminalpp::behaviour const &beh,
         terminalpp::terminal_state &state,
-        terminal::write_function const &write_fn) const;
+        WriteContinuation &&wc) const
+    {
+        detail::move_cursor(state.cursor_position_, destination_, beh, wc);
+        state.cursor_position_ = destination_;
+    }
 
 private:
     point destination_;
@@ -320,7 +561,7 @@ public:
     void operator()(
         terminalpp::behaviour const &beh,
         terminalpp::terminal_state &state,
-        terminal::write_function const &write_fn) const;
+        write_continuation write_fn) const;
 };
 
 //* =========================================================================
@@ -336,7 +577,7 @@ public:
     void operator()(
         terminalpp::behaviour const &beh,
         terminalpp::terminal_state &state,
-        terminal::write_function const &write_fn) const;
+        write_continuation write_fn) const;
 };
 
 //* =========================================================================
@@ -351,7 +592,7 @@ public:
     void operator()(
         terminalpp::behaviour const &beh,
         terminalpp::terminal_state &state,
-        terminal::write_function const &write_fn) const;
+        write_continuation write_fn) const;
 };
 
 //* =========================================================================
@@ -366,7 +607,7 @@ public:
     void operator()(
         terminalpp::behaviour const &beh,
         terminalpp::terminal_state &state,
-        terminal::write_function const &write_fn) const;
+        write_continuation write_fn) const;
 };
 
 //* =========================================================================
@@ -381,7 +622,7 @@ public:
     void operator()(
         terminalpp::behaviour const &beh,
         terminalpp::terminal_state &state,
-        terminal::write_function const &write_fn) const;
+        write_continuation write_fn) const;
 };
 
 //* =========================================================================
@@ -397,7 +638,7 @@ public:
     void operator()(
         terminalpp::behaviour const &beh,
         terminalpp::terminal_state &state,
-        terminal::write_function const &write_fn) const;
+        write_continuation write_fn) const;
 };
 
 //* =========================================================================
@@ -413,7 +654,7 @@ public:
     void operator()(
         terminalpp::behaviour const &beh,
         terminalpp::terminal_state &state,
-        terminal::write_function const &write_fn) const;
+        write_continuation write_fn) const;
 };
 
 //* =========================================================================
@@ -428,7 +669,7 @@ public:
     void operator()(
         terminalpp::behaviour const &beh,
         terminalpp::terminal_state &state,
-        terminal::write_function const &write_fn) const;
+        write_continuation write_fn) const;
 };
 
 //* =========================================================================
@@ -444,7 +685,7 @@ public:
     void operator()(
         terminalpp::behaviour const &beh,
         terminalpp::terminal_state &state,
-        terminal::write_function const &write_fn) const;
+        write_continuation write_fn) const;
 };
 
 //* =========================================================================
@@ -460,7 +701,7 @@ public:
     void operator()(
         terminalpp::behaviour const &beh,
         terminalpp::terminal_state &state,
-        terminal::write_function const &write_fn) const;
+        write_continuation write_fn) const;
 };
 
 //* =========================================================================
@@ -470,13 +711,31 @@ public:
 class TERMINALPP_EXPORT enable_mouse
 {
 public:
+    //* =====================================================================
+    /// \brief Constructor.  Mouse events are reported in the normal
+    /// encoding.
+    //* =====================================================================
+    enable_mouse() = default;
+
+    //* =====================================================================
+    /// \brief Constructor.  Mouse events are reported in the given
+    /// encoding if the terminal supports it, and in the normal encoding
+    /// otherwise.
+    //* =====================================================================
+    explicit enable_mouse(mouse::encoding encoding) : encoding_(encoding)
+    {
+    }
+
     //* =====================================================================
     /// \brief Writes ANSI codes necessary to enable the mouse
     //* =====================================================================
     void operator()(
         terminalpp::behaviour const &beh,
         terminalpp::terminal_state &state,
-        terminal::write_function const &write_fn) const;
+        write_continuation write_fn) const;
+
+private:
+    mouse::encoding encoding_ = mouse::encoding::normal;
 };
 
 //* =========================================================================
@@ -492,7 +751,40 @@ public:
     void operator()(
         terminalpp::behaviour const &beh,
         terminalpp::terminal_state &state,
-        terminal::write_function const &write_fn) const;
+        write_continuation write_fn) const;
+};
+
+//* =========================================================================
+/// \brief A manipulator that enables bracketed paste mode according to the
+/// terminal behaviour.  In this mode, pasted text is read as a single paste
+/// token.
+//* =========================================================================
+class TERMINALPP_EXPORT enable_bracketed_paste
+{
+public:
+    //* =====================================================================
+    /// \brief Writes ANSI codes necessary to enable bracketed paste mode
+    //* =====================================================================
+    void operator()(
+        terminalpp::behaviour const &beh,
+        terminalpp::terminal_state &state,
+        write_continuation write_fn) const;
+};
+
+//* =========================================================================
+/// \brief A manipulator that disables bracketed paste mode according to the
+/// terminal behaviour.
+//* =========================================================================
+class TERMINALPP_EXPORT disable_bracketed_paste
+{
+public:
+    //* =====================================================================
+    /// \brief Writes ANSI codes necessary to disable bracketed paste mode
+    //* =====================================================================
+    void operator()(
+        terminalpp::behaviour const &beh,
+        terminalpp::terminal_state &state,
+        write_continuation write_fn) const;
 };
 
 //* =========================================================================
@@ -512,7 +804,7 @@ public:
     void operator()(
         terminalpp::behaviour const &beh,
         terminalpp::terminal_state &state,
-        terminal::write_function const &write_fn) const;
+        write_continuation write_fn) const;
 
 private:
     std::string title_;
@@ -530,7 +822,7 @@ public:
     void operator()(
         terminalpp::behaviour const &beh,
         terminalpp::terminal_state &state,
-        terminal::write_function const &write_fn) const;
+        write_continuation write_fn) const;
 };
 
 //* =========================================================================
@@ -545,7 +837,42 @@ public:
     void operator()(
         terminalpp::behaviour const &beh,
         terminalpp::terminal_state &state,
-        terminal::write_function const &write_fn) const;
+        write_continuation write_fn) const;
 };
 
+//* =========================================================================
+/// \brief Write a single element to the terminal
+//* =========================================================================
+template <typename Channel>
+basic_terminal<Channel> &basic_terminal<Channel>::operator<<(
+    terminalpp::element const &elem)
+{
+    buffer_manipulator(write_optional_default_attribute());
+    buffer_manipulator(write_element(elem));
+    flush_if_over_threshold();
+
+    return *this;
+}
+
+//* =========================================================================
+/// \brief Write an attributed string to the terminal.
+//* =========================================================================
+template <typename Channel>
+basic_terminal<Channel> &basic_terminal<Channel>::operator<<(
+    terminalpp::string const &text)
+{
+    buffer_manipulator(write_optional_default_attribute());
+
+    for (auto const &elem : text)
+    {
+        buffer_manipulator(write_element(elem));
+    }
+
+    flush_if_over_threshold();
+
+    return *this;
+}
+
+extern template class TERMINALPP_EXPORT basic_terminal<any_channel>;
+
 }  // namespace terminalpp
@@ -1,10 +1,12 @@
 #pragma once
 
+#include "terminalpp/attribute_transition_cache.hpp"
 #include "terminalpp/detail/parser.hpp"
 #include "terminalpp/element.hpp"
 #include "terminalpp/extent.hpp"
 #include "terminalpp/point.hpp"
 
+#include <memory>
 #include <optional>
 
 namespace terminalpp {
@@ -36,6 +38,12 @@ struct TERMINALPP_EXPORT terminal_state
     /// \brief Whether the cursor is visible or not.
     std::optional<bool> cursor_visible_;
 
+    /// \brief The encoding of mouse events that was last enabled.
+    mouse::encoding mouse_encoding_ = mouse::encoding::normal;
+
+    /// \brief A cache of encoded attribute transitions, if one is in use.
+    std::shared_ptr<attribute_transition_cache> attribute_transition_cache_;
+
     /// \brief A parser for reading input.
     detail::parser input_parser_;
 };
@@ -2,6 +2,7 @@
 
 #include "terminalpp/control_sequence.hpp"
 #include "terminalpp/mouse.hpp"
+#include "terminalpp/paste.hpp"
 #include "terminalpp/virtual_key.hpp"
 
 #include <span>
@@ -13,7 +14,8 @@ namespace terminalpp {
 using token = std::variant<
     terminalpp::virtual_key,
     terminalpp::mouse::event,
-    terminalpp::control_sequence>;
+    terminalpp::control_sequence,
+    terminalpp::paste>;
 
 using tokens = std::span<token const>;
 using token_storage = std::vector<token>;
@@ -254,6 +254,12 @@ constexpr vk_modifier &operator&=(
     return lhs;
 }
 
+//* =========================================================================
+/// \brief Streaming output operator
+//* =========================================================================
+TERMINALPP_EXPORT
+std::ostream &operator<<(std::ostream &out, vk_modifier const &vkm);
+
 //* =========================================================================
 /// \brief Streaming output operator
 //* =========================================================================
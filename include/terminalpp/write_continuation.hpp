@@ -0,0 +1,123 @@
+#pragma once
+
+#include "terminalpp/core.hpp"
+
+#include <concepts>
+#include <memory>
+#include <type_traits>
+
+namespace terminalpp {
+
+//* =========================================================================
+/// \brief Bytes that have static storage duration, such as a constant
+/// escape sequence.
+///
+/// A write function that accepts static_bytes may refer to them rather than
+/// copying them, since they remain valid for the life of the program.
+//* =========================================================================
+struct static_bytes
+{
+    constexpr explicit static_bytes(bytes static_data) noexcept
+      : data(static_data)
+    {
+    }
+
+    bytes data;
+};
+
+//* =========================================================================
+/// \brief A non-owning reference to a function that accepts bytes.
+///
+/// This is the write function that is passed to the built-in manipulators.
+/// Unlike a std::function, it never allocates, and calling it costs a
+/// single indirect call, which matters because a manipulator may call it
+/// once for each fragment of its output.
+///
+/// \par Usage
+/// Any function object that can be called with terminalpp::bytes, including
+/// a std::function, converts to a write_continuation.  Since it refers to
+/// that object rather than copying it, a write_continuation should only be
+/// used as a function parameter, and never stored.
+/// \par
+/// static_bytes may also be written.  If the referenced function accepts
+/// them, then they are passed on as they are; otherwise, it is called with
+/// their data.
+//* =========================================================================
+class write_continuation
+{
+public:
+    //* =====================================================================
+    /// \brief Constructor
+    //* =====================================================================
+    template <typename Function>
+        requires(
+            !std::same_as<std::remove_cvref_t<Function>, write_continuation>
+            && std::invocable<Function &, bytes>)
+    write_continuation(Function &&fn) noexcept  // NOLINT
+      : function_(
+          const_cast<void *>(  // NOLINT
+              static_cast<void const *>(std::addressof(fn)))),
+        call_([](void *function, bytes data) {
+            (*static_cast<std::remove_reference_t<Function> *>(function))(
+                data);
+        }),
+        call_static_([](void *function, bytes data) {
+            auto &target =
+                *static_cast<std::remove_reference_t<Function> *>(function);
+
+            if constexpr (std::invocable<Function &, static_bytes>)
+            {
+                target(static_bytes{data});
+            }
+            else
+            {
+                target(data);
+            }
+        })
+    {
+    }
+
+    //* =====================================================================
+    /// \brief Calls the referenced function with the data.
+    //* =====================================================================
+    void operator()(bytes data) const
+    {
+        call_(function_, data);
+    }
+
+    //* =====================================================================
+    /// \brief Calls the referenced function with the static data.
+    //* =====================================================================
+    void operator()(static_bytes data) const
+    {
+        call_static_(function_, data.data);
+    }
+
+private:
+    void *function_;
+    void (*call_)(void *, bytes);
+    void (*call_static_)(void *, bytes);
+};
+
+namespace detail {
+
+//* =========================================================================
+/// \brief Writes data that has static storage duration to the write
+/// continuation, as static_bytes if it accepts them.
+//* =========================================================================
+template <class WriteContinuation>
+constexpr void write_static(WriteContinuation &&wc, bytes data)
+{
+    if constexpr (std::invocable<WriteContinuation &, static_bytes>)
+    {
+        wc(static_bytes{data});
+    }
+    else
+    {
+        wc(data);
+    }
+}
+
+}  // namespace detail
+
+}  // namespace terminalpp
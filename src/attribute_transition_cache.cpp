@@ -0,0 +1,63 @@
+#include "terminalpp/attribute_transition_cache.hpp"
+
+#include <boost/container_hash/hash.hpp>
+
+#include <algorithm>
+
+namespace terminalpp {
+
+// ==========================================================================
+// CONSTRUCTOR
+// ==========================================================================
+attribute_transition_cache::attribute_transition_cache(std::size_t capacity)
+  : slots_((std::max)(capacity, std::size_t{1}))
+{
+}
+
+// ==========================================================================
+// CAPACITY
+// ==========================================================================
+std::size_t attribute_transition_cache::capacity() const
+{
+    return slots_.size();
+}
+
+// ==========================================================================
+// HITS
+// ==========================================================================
+std::size_t attribute_transition_cache::hits() const
+{
+    return hits_;
+}
+
+// ==========================================================================
+// MISSES
+// ==========================================================================
+std::size_t attribute_transition_cache::misses() const
+{
+    return misses_;
+}
+
+// ==========================================================================
+// CLEAR
+// ==========================================================================
+void attribute_transition_cache::clear()
+{
+    std::ranges::for_each(slots_, [](slot &s) { s.occupied_ = false; });
+    hits_ = 0;
+    misses_ = 0;
+}
+
+// ==========================================================================
+// SLOT_FOR
+// ==========================================================================
+attribute_transition_cache::slot &attribute_transition_cache::slot_for(
+    attribute const &source, attribute const &dest)
+{
+    std::size_t seed = hash_value(source);
+    boost::hash_combine(seed, hash_value(dest));
+
+    return slots_[seed % slots_.size()];
+}
+
+}  // namespace terminalpp
@@ -1,6 +1,7 @@
 #include "terminalpp/canvas.hpp"
 
-#include "terminalpp/algorithm/for_each_in_region.hpp"
+#include <algorithm>
+#include <cstddef>
 
 namespace terminalpp {
 
@@ -39,6 +40,7 @@ canvas::column_proxy::column_proxy(canvas &cvs, coordinate_type column)
 // ==========================================================================
 element &canvas::column_proxy::operator[](coordinate_type row)
 {
+    canvas_.mark_element_dirty(column_, row);
     return canvas_.get_element(column_, row);
 }
 
@@ -85,25 +87,23 @@ void canvas::resize(extent const &size)
     std::vector<element> new_grid(static_cast<std::vector<element>::size_type>(
         size.width_ * size.height_));
 
-    auto min_width = (std::min)(size.width_, size_.width_);
-    auto min_height = (std::min)(size.height_, size_.height_);
+    auto const min_width =
+        static_cast<std::size_t>((std::min)(size.width_, size_.width_));
+    auto const min_height = (std::min)(size.height_, size_.height_);
+    canvas const &self = *this;
 
-    for_each_in_region(
-        *this,
-        {
-            {},
-            {min_width, min_height}
-    },
-        [&size, &new_grid](
-            element const &elem, coordinate_type column, coordinate_type row) {
-            auto const new_grid_pos =
-                static_cast<std::vector<element>::size_type>(
-                    row * size.width_ + column);
-            new_grid[new_grid_pos] = elem;
-        });
+    for (coordinate_type row = 0; row < min_height; ++row)
+    {
+        std::ranges::copy(
+            self.row(row).first(min_width),
+            new_grid.begin() + static_cast<std::ptrdiff_t>(row * size.width_));
+    }
 
     size_ = size;
     grid_.swap(new_grid);
+
+    // All of the content has moved, and so the whole canvas is now dirty.
+    set_dirty_tracking(dirty_tracking_);
 }
 
 // ==========================================================================
@@ -111,6 +111,7 @@ void canvas::resize(extent const &size)
 // ==========================================================================
 canvas::iterator canvas::begin()
 {
+    mark_dirty({{}, size_});
     return begin_pointer(grid_);
 }
 
@@ -127,6 +128,7 @@ canvas::const_iterator canvas::begin() const
 // ==========================================================================
 canvas::iterator canvas::end()
 {
+    mark_dirty({{}, size_});
     return end_pointer(grid_);
 }
 
@@ -154,6 +156,169 @@ canvas::const_column_proxy canvas::operator[](coordinate_type column) const
     return {*this, column};
 }
 
+// ==========================================================================
+// ROW
+// ==========================================================================
+std::span<element> canvas::row(coordinate_type row)
+{
+    mark_dirty({
+        {0,            row},
+        {size_.width_, 1  }
+    });
+
+    return row_elements(row);
+}
+
+// ==========================================================================
+// ROW
+// ==========================================================================
+std::span<element const> canvas::row(coordinate_type row) const
+{
+    return {
+        grid_.data() + static_cast<std::size_t>(row * size_.width_),
+        static_cast<std::size_t>(size_.width_)};
+}
+
+// ==========================================================================
+// FILL_ROW
+// ==========================================================================
+void canvas::fill_row(coordinate_type row, element const &elem)
+{
+    std::ranges::fill(this->row(row), elem);
+}
+
+// ==========================================================================
+// COPY_ROW
+// ==========================================================================
+void canvas::copy_row(coordinate_type source_row, coordinate_type dest_row)
+{
+    std::ranges::copy(row_elements(source_row), row(dest_row).begin());
+}
+
+// ==========================================================================
+// BLIT
+// ==========================================================================
+void canvas::blit(point const &origin, string const &text)
+{
+    // Text on a row outside of the canvas is clipped away entirely.
+    if (origin.y_ < 0 || origin.y_ >= size_.height_)
+    {
+        return;
+    }
+
+    // Clip the text to the columns of the canvas.
+    auto const first_column = (std::max)(origin.x_, coordinate_type{0});
+    auto const last_column = (std::min)(
+        origin.x_ + static_cast<coordinate_type>(text.size()), size_.width_);
+
+    if (first_column >= last_column)
+    {
+        return;
+    }
+
+    mark_dirty({
+        {first_column,               origin.y_},
+        {last_column - first_column, 1        }
+    });
+
+    std::copy(
+        text.begin() + (first_column - origin.x_),
+        text.begin() + (last_column - origin.x_),
+        row_elements(origin.y_).begin() + first_column);
+}
+
+// ==========================================================================
+// ROW_ELEMENTS
+// ==========================================================================
+std::span<element> canvas::row_elements(coordinate_type row)
+{
+    return {
+        grid_.data() + static_cast<std::size_t>(row * size_.width_),
+        static_cast<std::size_t>(size_.width_)};
+}
+
+// ==========================================================================
+// SET_DIRTY_TRACKING
+// ==========================================================================
+void canvas::set_dirty_tracking(bool enabled)
+{
+    dirty_tracking_ = enabled;
+    dirty_rows_.clear();
+
+    if (dirty_tracking_)
+    {
+        dirty_rows_.resize(
+            static_cast<std::vector<column_range>::size_type>(size_.height_),
+            {0, size_.width_});
+    }
+}
+
+// ==========================================================================
+// MARK_DIRTY
+// ==========================================================================
+void canvas::mark_dirty(rectangle const &region)
+{
+    if (!dirty_tracking_)
+    {
+        return;
+    }
+
+    auto const first_column = (std::max)(region.origin_.x_, coordinate_type{0});
+    auto const last_column =
+        (std::min)(region.origin_.x_ + region.size_.width_, size_.width_);
+    auto const first_row = (std::max)(region.origin_.y_, coordinate_type{0});
+    auto const last_row =
+        (std::min)(region.origin_.y_ + region.size_.height_, size_.height_);
+
+    if (first_column >= last_column)
+    {
+        return;
+    }
+
+    for (auto row = first_row; row < last_row; ++row)
+    {
+        auto &dirty = dirty_rows_[static_cast<std::size_t>(row)];
+
+        if (dirty.begin_ == dirty.end_)
+        {
+            dirty = {first_column, last_column};
+        }
+        else
+        {
+            dirty.begin_ = (std::min)(dirty.begin_, first_column);
+            dirty.end_ = (std::max)(dirty.end_, last_column);
+        }
+    }
+}
+
+// ==========================================================================
+// MARK_CLEAN
+// ==========================================================================
+void canvas::mark_clean()
+{
+    std::ranges::fill(dirty_rows_, column_range{0, 0});
+}
+
+// ==========================================================================
+// DIRTY_COLUMNS
+// ==========================================================================
+canvas::column_range canvas::dirty_columns(coordinate_type row) const
+{
+    return dirty_tracking_ ? dirty_rows_[static_cast<std::size_t>(row)]
+                           : column_range{0, size_.width_};
+}
+
+// ==========================================================================
+// MARK_ELEMENT_DIRTY
+// ==========================================================================
+void canvas::mark_element_dirty(coordinate_type column, coordinate_type row)
+{
+    mark_dirty({
+        {column, row},
+        {1,      1  }
+    });
+}
+
 // ==========================================================================
 // GET_ELEMENT
 // ==========================================================================
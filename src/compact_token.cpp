@@ -0,0 +1,127 @@
+#include "terminalpp/compact_token.hpp"
+
+#include "terminalpp/detail/overloaded.hpp"
+
+#include <cassert>
+
+namespace terminalpp {
+
+// ==========================================================================
+// CLEAR
+// ==========================================================================
+void token_batch::clear() noexcept
+{
+    tokens_.clear();
+    sequences_.clear();
+}
+
+// ==========================================================================
+// PUSH_BACK
+// ==========================================================================
+void token_batch::push_back(token &&tok)
+{
+    tokens_.push_back(std::visit(
+        detail::overloaded{
+            [this](virtual_key &key) -> compact_token {
+                compact_virtual_key result{
+                    .key = key.key,
+                    .modifiers = key.modifiers,
+                    .repeat_count = key.repeat_count};
+
+                if (auto *const seq =
+                        std::get_if<control_sequence>(&key.sequence))
+                {
+                    result.sequence = store(std::move(*seq));
+                }
+                else
+                {
+                    result.character = std::get<byte>(key.sequence);
+                }
+
+                return result;
+            },
+            [this](control_sequence &seq) -> compact_token {
+                return compact_control_sequence{store(std::move(seq))};
+            },
+            [](auto const &other) -> compact_token { return other; }},
+        tok));
+}
+
+// ==========================================================================
+// TOKENS
+// ==========================================================================
+std::span<compact_token const> token_batch::tokens() const noexcept
+{
+    return tokens_;
+}
+
+// ==========================================================================
+// BACK
+// ==========================================================================
+compact_token &token_batch::back() noexcept
+{
+    assert(!tokens_.empty());
+    return tokens_.back();
+}
+
+// ==========================================================================
+// SEQUENCE
+// ==========================================================================
+control_sequence const &token_batch::sequence(
+    std::uint32_t index) const noexcept
+{
+    assert(index < sequences_.size());
+    return sequences_[index];
+}
+
+// ==========================================================================
+// EXPAND
+// ==========================================================================
+token token_batch::expand(compact_token const &tok) const
+{
+    return std::visit(
+        detail::overloaded{
+            [this](compact_virtual_key const &key) -> token {
+                return virtual_key{
+                    .key = key.key,
+                    .modifiers = key.modifiers,
+                    .repeat_count = key.repeat_count,
+                    .sequence =
+                        key.sequence == compact_virtual_key::no_sequence
+                            ? virtual_key::input_sequence{key.character}
+                            : virtual_key::input_sequence{
+                                sequence(key.sequence)}};
+            },
+            [this](compact_control_sequence const &seq) -> token {
+                return sequence(seq.index);
+            },
+            [](auto const &other) -> token { return other; }},
+        tok);
+}
+
+// ==========================================================================
+// SIZE
+// ==========================================================================
+std::size_t token_batch::size() const noexcept
+{
+    return tokens_.size();
+}
+
+// ==========================================================================
+// EMPTY
+// ==========================================================================
+bool token_batch::empty() const noexcept
+{
+    return tokens_.empty();
+}
+
+// ==========================================================================
+// STORE
+// ==========================================================================
+std::uint32_t token_batch::store(control_sequence &&seq)
+{
+    sequences_.push_back(std::move(seq));
+    return static_cast<std::uint32_t>(sequences_.size() - 1);
+}
+
+}  // namespace terminalpp
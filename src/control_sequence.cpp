@@ -2,7 +2,7 @@
 
 #include <algorithm>
 #include <iostream>
-#include <ranges>
+#include <iterator>
 #include <utility>
 
 namespace terminalpp {
@@ -62,25 +62,15 @@ void output_meta(std::ostream &out, bool meta, bool &comma)
 // OUTPUT_ARGUMENTS
 // ==========================================================================
 void output_arguments(
-    std::ostream &out, std::vector<byte_storage> const &arguments, bool &comma)
+    std::ostream &out, control_sequence_arguments const &arguments, bool &comma)
 {
     if (!arguments.empty())
     {
         output_comma(out, comma);
 
+        // The text of the arguments is already separated by semicolons.
         out << R"(args:")";
-
-        for (auto const &value : arguments | std::views::take(1))
-        {
-            std::ranges::copy(value, std::ostream_iterator<char>(out));
-        }
-
-        for (auto const &value : arguments | std::views::drop(1))
-        {
-            out << ";";
-            std::ranges::copy(value, std::ostream_iterator<char>(out));
-        }
-
+        std::ranges::copy(arguments.text(), std::ostream_iterator<char>(out));
         out << R"(")";
     }
 }
@@ -0,0 +1,155 @@
+#include "terminalpp/detail/cursor_movement.hpp"
+
+#include <cstddef>
+
+namespace terminalpp::detail {
+namespace {
+
+// ==========================================================================
+// ROUTE_COST
+// ==========================================================================
+std::size_t route_cost(cursor_route const &route, behaviour const &beh)
+{
+    std::size_t cost = 0;
+
+    for (auto const &stp : route)
+    {
+        write_cursor_step(
+            stp, beh, [&cost](bytes data) { cost += data.size(); });
+    }
+
+    return cost;
+}
+
+// ==========================================================================
+// VERTICAL_STEPS
+// ==========================================================================
+// Returns the candidate steps that move the cursor from the source row to
+// the destination row without affecting its column.
+cursor_route vertical_steps(
+    point const &source, point const &destination, behaviour const &beh)
+{
+    auto const distance = destination.y_ - source.y_;
+
+    if (distance == 0)
+    {
+        return {
+            {cursor_movement::none, destination, 0}
+        };
+    }
+
+    cursor_route result;
+
+    if (distance < 0)
+    {
+        result.push_back({cursor_movement::cursor_up, destination, -distance});
+    }
+    else
+    {
+        result.push_back({cursor_movement::cursor_down, destination, distance});
+    }
+
+    if (beh.supports_vpa)
+    {
+        result.push_back({cursor_movement::line_position_absolute, destination, 0});
+    }
+
+    return result;
+}
+
+// ==========================================================================
+// HORIZONTAL_STEPS
+// ==========================================================================
+// Returns the candidate steps that move the cursor from the source column
+// to the destination column without affecting its row.
+cursor_route horizontal_steps(
+    coordinate_type const source_column,
+    point const &destination,
+    behaviour const &beh)
+{
+    auto const distance = destination.x_ - source_column;
+
+    if (distance == 0)
+    {
+        return {
+            {cursor_movement::none, destination, 0}
+        };
+    }
+
+    cursor_route result;
+
+    if (beh.supports_cha)
+    {
+        result.push_back(
+            {cursor_movement::cursor_horizontal_absolute, destination, 0});
+    }
+
+    if (distance < 0)
+    {
+        result.push_back({cursor_movement::cursor_backward, destination, -distance});
+        result.push_back({cursor_movement::backspace, destination, -distance});
+    }
+    else
+    {
+        result.push_back({cursor_movement::cursor_forward, destination, distance});
+    }
+
+    return result;
+}
+
+}  // namespace
+
+// ==========================================================================
+// PLAN_CURSOR_ROUTE
+// ==========================================================================
+cursor_route plan_cursor_route(
+    point const &source, point const &destination, behaviour const &beh)
+{
+    cursor_route best = {
+        {cursor_movement::cursor_position, destination, 0}
+    };
+    auto best_cost = route_cost(best, beh);
+
+    auto const consider = [&](cursor_route const &candidate) {
+        if (auto const cost = route_cost(candidate, beh); cost < best_cost)
+        {
+            best = candidate;
+            best_cost = cost;
+        }
+    };
+
+    // Routes that move relative to, or absolutely from, the current row
+    // and column.
+    for (auto const &vertical : vertical_steps(source, destination, beh))
+    {
+        for (auto const &horizontal :
+             horizontal_steps(source.x_, destination, beh))
+        {
+            consider({vertical, horizontal});
+        }
+    }
+
+    // Routes that begin with a carriage return to the start of the line.
+    // Line feeds are only ever used after a carriage return, so that the
+    // result is the same whether or not the terminal is in "new line"
+    // mode.
+    cursor_step const carriage_return = {cursor_movement::carriage_return, destination, 0};
+    auto line_verticals = vertical_steps(source, destination, beh);
+
+    if (auto const distance = destination.y_ - source.y_; distance > 0)
+    {
+        line_verticals.push_back({cursor_movement::line_feed, destination, distance});
+    }
+
+    for (auto const &vertical : line_verticals)
+    {
+        for (auto const &horizontal : horizontal_steps(0, destination, beh))
+        {
+            consider({carriage_return, vertical, horizontal});
+        }
+    }
+
+    return best;
+}
+
+}  // namespace terminalpp::detail
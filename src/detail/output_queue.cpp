@@ -0,0 +1,128 @@
+#include "terminalpp/detail/output_queue.hpp"
+
+#include <algorithm>
+#include <cerrno>
+
+namespace terminalpp::detail {
+
+// ==========================================================================
+// PUSH
+// ==========================================================================
+void output_queue::push(bytes data)
+{
+    if (!data.empty())
+    {
+        fragments_.emplace_back(data.begin(), data.end());
+        size_ += data.size();
+    }
+}
+
+// ==========================================================================
+// PUSH
+// ==========================================================================
+void output_queue::push(std::span<bytes const> data, std::size_t sent)
+{
+    for (auto fragment : data)
+    {
+        auto const skipped = (std::min)(sent, fragment.size());
+        sent -= skipped;
+        push(fragment.subspan(skipped));
+    }
+}
+
+// ==========================================================================
+// GATHER
+// ==========================================================================
+std::size_t output_queue::gather(std::span<iovec> fragments)
+{
+    auto const count = (std::min)(fragments_.size(), fragments.size());
+
+    for (std::size_t index = 0; index < count; ++index)
+    {
+        auto &fragment = fragments_[index];
+        auto const offset = index == 0 ? offset_ : 0;
+        fragments[index] = {
+            .iov_base = fragment.data() + offset,
+            .iov_len = fragment.size() - offset};
+    }
+
+    return count;
+}
+
+// ==========================================================================
+// CONSUME
+// ==========================================================================
+void output_queue::consume(std::size_t count)
+{
+    size_ -= count;
+
+    while (count != 0)
+    {
+        auto const unsent = fragments_.front().size() - offset_;
+
+        if (count < unsent)
+        {
+            offset_ += count;
+            break;
+        }
+
+        count -= unsent;
+        fragments_.pop_front();
+        offset_ = 0;
+    }
+}
+
+// ==========================================================================
+// CLEAR
+// ==========================================================================
+void output_queue::clear()
+{
+    fragments_.clear();
+    offset_ = 0;
+    size_ = 0;
+}
+
+// ==========================================================================
+// EMPTY
+// ==========================================================================
+bool output_queue::empty() const
+{
+    return fragments_.empty();
+}
+
+// ==========================================================================
+// SIZE
+// ==========================================================================
+std::size_t output_queue::size() const
+{
+    return size_;
+}
+
+// ==========================================================================
+// GATHER
+// ==========================================================================
+std::size_t gather(std::span<bytes const> data, std::span<iovec> fragments)
+{
+    auto const count = (std::min)(data.size(), fragments.size());
+
+    for (std::size_t index = 0; index < count; ++index)
+    {
+        // iovec is shared between reading and writing, and so its base is
+        // not const, though writing never modifies it.
+        fragments[index] = {
+            .iov_base = const_cast<byte *>(data[index].data()),  // NOLINT
+            .iov_len = data[index].size()};
+    }
+
+    return count;
+}
+
+// ==========================================================================
+// WOULD_BLOCK
+// ==========================================================================
+bool would_block()
+{
+    return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+}
+
+}  // namespace terminalpp::detail
@@ -5,250 +5,565 @@
 #include "terminalpp/ansi/mouse.hpp"
 #include "terminalpp/ansi/protocol.hpp"
 #include "terminalpp/detail/ascii.hpp"
+#include "terminalpp/detail/well_known_virtual_key.hpp"
 
 #include <algorithm>
+#include <array>
+#include <limits>
+#include <utility>
 #include <cassert>
-#include <cctype>
 
 namespace terminalpp::detail {
 
 namespace {
 
-constexpr bool is_csi_extension_character(byte input)
+// The end marker of a bracketed paste: CSI 201~.
+constexpr byte paste_terminator[] = {
+    terminalpp::detail::ascii::esc,
+    terminalpp::ansi::control7::csi[1],
+    terminalpp::detail::ascii::two,
+    terminalpp::detail::ascii::zero,
+    terminalpp::detail::ascii::one,
+    ansi::csi::keypad_function,
+};
+
+}  // namespace
+
+// The constexpr tables that drive the parser.  Each input byte is first
+// mapped to its class, and the pair of the current state and that class
+// then indexes a dense table of transitions, each of which names the next
+// state and the action to perform on the way there.
+struct parser::tables
+{
+    static constexpr std::size_t state_count =
+        static_cast<std::size_t>(state::paste) + 1;
+    static constexpr std::size_t byte_class_count =
+        static_cast<std::size_t>(byte_class::extender) + 1;
+
+    using transition_row = std::array<transition, byte_class_count>;
+
+    static constexpr auto byte_classes = [] {
+        std::array<byte_class, 256> table{};
+        table.fill(byte_class::other);
+
+        table[terminalpp::detail::ascii::esc] = byte_class::esc;
+        table[terminalpp::detail::ascii::cr] = byte_class::cr;
+        table[terminalpp::detail::ascii::lf] = byte_class::lf;
+        table[terminalpp::detail::ascii::nul] = byte_class::nul;
+        table[terminalpp::ansi::control8::csi] = byte_class::csi8;
+        table[terminalpp::ansi::control8::ss3] = byte_class::ss3_8;
+        table[terminalpp::ansi::ps] = byte_class::separator;
+        table[terminalpp::ansi::sub_ps] = byte_class::sub_separator;
+        table[terminalpp::ansi::csi::mouse_tracking] =
+            byte_class::mouse_tracking;
+        table[terminalpp::ansi::mouse::sgr_release] =
+            byte_class::mouse_release;
+        table[terminalpp::detail::ascii::question_mark] =
+            byte_class::extender;
+        table[terminalpp::detail::ascii::greater_than] = byte_class::extender;
+        table[terminalpp::detail::ascii::exclamation_mark] =
+            byte_class::extender;
+        table[terminalpp::ansi::mouse::sgr_introducer] = byte_class::extender;
+
+        for (byte ch = terminalpp::detail::ascii::zero;
+             ch <= terminalpp::detail::ascii::nine;
+             ++ch)
+        {
+            table[ch] = byte_class::digit;
+        }
+
+        return table;
+    }();
+
+    static constexpr auto transitions = [] {
+        std::array<transition_row, state_count> table{};
+
+        auto const row = [&table](state st) -> transition_row & {
+            return table[static_cast<std::size_t>(st)];
+        };
+
+        auto const set = [&row](state st, byte_class cls, transition tr) {
+            row(st)[static_cast<std::size_t>(cls)] = tr;
+        };
+
+        // Idle: ordinary characters are emitted as they are, and anything
+        // else begins a sequence or an enter key.
+        row(state::idle).fill({state::idle, action::emit_character});
+        set(state::idle,
+            byte_class::esc,
+            {state::escape, action::begin_escape});
+        set(state::idle, byte_class::cr, {state::cr, action::emit_enter});
+        set(state::idle, byte_class::lf, {state::lf, action::emit_enter});
+        set(state::idle,
+            byte_class::csi8,
+            {state::arguments, action::begin_csi});
+        set(state::idle,
+            byte_class::ss3_8,
+            {state::arguments, action::begin_ss3});
+
+        // CR and LF: the other half of a CRLF/LFCR pair (or a CRNUL) is
+        // swallowed.  Anything else is treated as if it were seen in the
+        // idle state.
+        row(state::cr).fill({state::idle, action::reparse_as_idle});
+        set(state::cr, byte_class::lf, {state::idle, action::none});
+        set(state::cr, byte_class::nul, {state::idle, action::none});
+
+        row(state::lf).fill({state::idle, action::reparse_as_idle});
+        set(state::lf, byte_class::cr, {state::idle, action::none});
+
+        // Escape: a further escape marks the sequence as meta; anything
+        // else is the sequence's initializer.
+        row(state::escape).fill({state::arguments, action::set_initializer});
+        set(state::escape, byte_class::esc, {state::escape, action::set_meta});
+
+        // Arguments: digits and separators accumulate arguments until a
+        // command character completes the sequence.
+        row(state::arguments).fill({state::idle, action::emit_sequence});
+        set(state::arguments,
+            byte_class::digit,
+            {state::arguments, action::append_digit});
+        set(state::arguments,
+            byte_class::separator,
+            {state::arguments, action::end_argument});
+        set(state::arguments,
+            byte_class::sub_separator,
+            {state::arguments, action::end_sub_argument});
+        set(state::arguments,
+            byte_class::extender,
+            {state::arguments, action::set_extender});
+        set(state::arguments,
+            byte_class::mouse_tracking,
+            {state::idle, action::dispatch_mouse});
+        set(state::arguments,
+            byte_class::mouse_release,
+            {state::idle, action::dispatch_mouse});
+
+        // Mouse: the three bytes of a normally-encoded report are taken as
+        // they come.
+        row(state::mouse0).fill({state::mouse1, action::set_mouse_event_type});
+        row(state::mouse1).fill({state::mouse2, action::set_mouse_x});
+        row(state::mouse2).fill({state::idle, action::emit_mouse_event});
+
+        // Paste: the text of a paste is scanned for its end marker in bulk
+        // by parse_paste rather than passing through this table.
+        row(state::paste).fill({state::paste, action::none});
+
+        return table;
+    }();
+
+    // Bytes that are passed straight through as virtual keys when in the
+    // idle state.
+    static constexpr auto ordinary_idle_bytes = [] {
+        std::array<bool, 256> table{};
+
+        for (std::size_t ch = 0; ch < table.size(); ++ch)
+        {
+            auto const cls = static_cast<std::size_t>(byte_classes[ch]);
+            table[ch] = transitions[static_cast<std::size_t>(state::idle)][cls]
+                            .act
+                     == action::emit_character;
+        }
+
+        return table;
+    }();
+
+    // The mouse event type for each possible (offset) button byte of a
+    // mouse report.  Unrecognised values are treated as no change.
+    static constexpr auto mouse_event_types = [] {
+        std::array<mouse::event_type, 256> table{};
+        table.fill(mouse::event_type::no_button_change);
+
+        auto const set = [&table](byte ansi_event, mouse::event_type event) {
+            table[ansi::mouse::mouse_value_offset + ansi_event] = event;
+        };
+
+        set(ansi::mouse::left_button_down,
+            mouse::event_type::left_button_down);
+        set(ansi::mouse::middle_button_down,
+            mouse::event_type::middle_button_down);
+        set(ansi::mouse::right_button_down,
+            mouse::event_type::right_button_down);
+        set(ansi::mouse::button_up, mouse::event_type::button_up);
+        set(ansi::mouse::no_button_change,
+            mouse::event_type::no_button_change);
+        set(ansi::mouse::scrollwheel_up, mouse::event_type::scrollwheel_up);
+        set(ansi::mouse::scrollwheel_down,
+            mouse::event_type::scrollwheel_down);
+
+        return table;
+    }();
+
+    [[nodiscard]] static constexpr transition lookup(
+        state current, byte input) noexcept
+    {
+        return transitions[static_cast<std::size_t>(current)]
+                          [static_cast<std::size_t>(byte_classes[input])];
+    }
+};
+
+parser::parser(std::size_t max_paste_size)
+  : max_paste_size_((std::max)(max_paste_size, std::size(paste_terminator))),
+    state_(state::idle)
 {
-    return input == terminalpp::detail::ascii::question_mark
-        || input == terminalpp::detail::ascii::greater_than
-        || input == terminalpp::detail::ascii::exclamation_mark;
 }
 
-}  // namespace
+std::optional<terminalpp::token> parser::operator()(byte input)
+{
+    release_pastes();
+    return advance(input);
+}
 
-parser::parser() : state_(state::idle)
+std::optional<terminalpp::token> parser::advance(byte input)
 {
+    if (state_ == state::paste)
+    {
+        bytes remaining{&input, 1};
+        return parse_paste(remaining);
+    }
+
+    auto const [next_state, act] = tables::lookup(state_, input);
+    state_ = next_state;
+    return perform(act, input);
 }
 
-std::optional<terminalpp::token> parser::parser::operator()(byte input)
+std::optional<terminalpp::token> parser::perform(action act, byte input)
 {
-    switch (state_)
+    switch (act)
     {
-        case state::idle:
-            return parse_idle(input);
-        case state::cr:
-            return parse_cr(input);
-        case state::lf:
-            return parse_lf(input);
-        case state::escape:
-            return parse_escape(input);
-        case state::arguments:
-            return parse_arguments(input);
-        case state::mouse0:
-            return parse_mouse0(input);
-        case state::mouse1:
-            return parse_mouse1(input);
-        case state::mouse2:
-            return parse_mouse2(input);
+        case action::none:
+            break;
+
+        case action::emit_character:
+            return make_ordinary_key(input);
+
+        case action::emit_enter:
+            return terminalpp::token{
+                terminalpp::virtual_key{
+                                        terminalpp::vk::enter,
+                                        terminalpp::vk_modifier::none,
+                                        1, '\n'_tb}
+            };
+
+        case action::begin_escape:
+            begin_sequence();
+            break;
+
+        case action::begin_csi:
+            begin_sequence();
+            initializer_ = terminalpp::ansi::control7::csi[1];
+            break;
+
+        case action::begin_ss3:
+            begin_sequence();
+            initializer_ = terminalpp::ansi::control7::ss3[1];
+            break;
+
+        case action::set_meta:
+            meta_ = true;
+            break;
+
+        case action::set_initializer:
+            initializer_ = input;
+            break;
+
+        case action::append_digit:
+            argument_text_.push_back(input);
+            parameters_.append_digit(input);
+            break;
+
+        case action::end_argument:
+            argument_text_.push_back(input);
+            parameters_.end_parameter();
+            break;
+
+        case action::end_sub_argument:
+            // Sub-arguments remain part of their argument's text.
+            argument_text_.push_back(input);
+            parameters_.end_sub_parameter();
+            break;
+
+        case action::set_extender:
+            extender_ = input;
+            break;
+
+        case action::dispatch_mouse:
+            // CSI < ... M/m is an SGR mouse report and CSI M begins a
+            // normal mouse report.  Otherwise, M and m are ordinary
+            // commands.
+            if (initializer_ == terminalpp::ansi::control7::csi[1])
+            {
+                if (extender_ == ansi::mouse::sgr_introducer)
+                {
+                    return make_sgr_mouse_event(input);
+                }
+
+                if (input == ansi::mouse::sgr_press)
+                {
+                    state_ = state::mouse0;
+                    break;
+                }
+            }
+
+            return perform(action::emit_sequence, input);
+
+        case action::emit_sequence:
+            parameters_.end_parameter();
+
+            if (initializer_ == terminalpp::ansi::control7::csi[1]
+                && input == ansi::csi::keypad_function
+                && parameters_.get(0) == ansi::csi::paste_begin)
+            {
+                // The start of a bracketed paste is not reported; the
+                // text is reported as a whole when the paste ends.
+                state_ = state::paste;
+                paste_buffer_.clear();
+                break;
+            }
+
+            // The parameters are only needed to recognise well-known
+            // virtual keys, and so they are not stored in the sequence.
+            return get_well_known_virtual_key(
+                terminalpp::control_sequence{
+                    initializer_,
+                    input,
+                    meta_,
+                    extender_,
+                    control_sequence_arguments::from_text(argument_text_)},
+                parameters_);
+
+        case action::set_mouse_event_type:
+            mouse_event_type_ = tables::mouse_event_types[input];
+            break;
+
+        case action::set_mouse_x:
+            // In addition to the offset described above, ANSI co-ordinates
+            // are 1-based, whereas Terminal++ is 0-based, which means an
+            // extra offset is required.
+            mouse_coordinate_.x_ = static_cast<coordinate_type>(
+                (input - ansi::mouse::mouse_value_offset) - 1);
+            break;
+
+        case action::emit_mouse_event:
+            mouse_coordinate_.y_ = static_cast<coordinate_type>(
+                (input - ansi::mouse::mouse_value_offset) - 1);
+            return {terminalpp::token{terminalpp::mouse::event{
+                mouse_event_type_, mouse_coordinate_}}};
+
+        case action::reparse_as_idle:
+            return advance(input);
+
         default:
-            assert(!"state out of range");
+            assert(!"action out of range");
     }
 
     return {};
 }
 
-std::optional<terminalpp::token> parser::parser::parse_idle(byte input)
+void parser::begin_sequence()
 {
-    if (input == terminalpp::detail::ascii::esc)
-    {
-        state_ = state::escape;
-        meta_ = false;
-        extender_ = '\0';
-        argument_ = {};
-        arguments_ = {};
-        return {};
-    }
-    else if (input == terminalpp::detail::ascii::cr)
-    {
-        state_ = state::cr;
-        return terminalpp::token{
-            terminalpp::virtual_key{
-                                    terminalpp::vk::enter,
-                                    terminalpp::vk_modifier::none,
-                                    1, '\n'_tb}
-        };
-    }
-    else if (input == terminalpp::detail::ascii::lf)
-    {
-        state_ = state::lf;
-        return terminalpp::token{
-            terminalpp::virtual_key{
-                                    terminalpp::vk::enter,
-                                    terminalpp::vk_modifier::none,
-                                    1, '\n'_tb}
-        };
-    }
-    else if (input == terminalpp::ansi::control8::csi)
-    {
-        state_ = state::arguments;
-        meta_ = false;
-        initializer_ = terminalpp::ansi::control7::csi[1];
-        extender_ = '\0';
-        argument_ = {};
-        arguments_ = {};
-        return {};
-    }
-    else if (input == terminalpp::ansi::control8::ss3)
-    {
-        state_ = state::arguments;
-        meta_ = false;
-        initializer_ = terminalpp::ansi::control7::ss3[1];
-        extender_ = '\0';
-        argument_ = {};
-        arguments_ = {};
-        return {};
-    }
-    else
-    {
-        return terminalpp::token{
-            terminalpp::virtual_key{
-                                    static_cast<vk>(input),
-                                    terminalpp::vk_modifier::none,
-                                    1, {input}}
-        };
-    }
+    meta_ = false;
+    extender_ = '\0';
+    parameters_.clear();
+    argument_text_.clear();
 }
 
-std::optional<terminalpp::token> parser::parse_cr(byte input)
+std::optional<terminalpp::token> parser::parse_paste(bytes &input)
 {
-    state_ = state::idle;
+    bytes const terminator{paste_terminator};
 
-    if (input == terminalpp::detail::ascii::lf
-        || input == terminalpp::detail::ascii::nul)
+    // The terminator may straddle the text that was buffered from previous
+    // input and this input.
+    for (auto matched =
+             (std::min)(terminator.size() - 1, paste_buffer_.size());
+         matched > 0;
+         --matched)
     {
-        return {};
+        auto const remainder = terminator.subspan(matched);
+
+        if (input.size() >= remainder.size()
+            && std::ranges::equal(
+                bytes{paste_buffer_}.last(matched), terminator.first(matched))
+            && std::ranges::equal(input.first(remainder.size()), remainder))
+        {
+            paste_buffer_.resize(paste_buffer_.size() - matched);
+            input = input.subspan(remainder.size());
+            state_ = state::idle;
+            return complete_buffered_paste();
+        }
     }
-    else
+
+    auto const found = std::ranges::search(input, terminator);
+
+    if (found.empty())
     {
-        return parse_idle(input);
+        // The buffer is never left full, and so there is always room for
+        // at least some of the input.
+        auto const text = input.first(
+            (std::min)(max_paste_size_ - paste_buffer_.size(), input.size()));
+        paste_buffer_.append(text.begin(), text.end());
+        input = input.subspan(text.size());
+
+        if (paste_buffer_.size() < max_paste_size_)
+        {
+            return {};
+        }
+
+        return complete_partial_paste();
     }
-}
 
-std::optional<terminalpp::token> parser::parse_lf(byte input)
-{
+    auto const text = input.first(
+        static_cast<std::size_t>(found.begin() - input.begin()));
+    input = input.subspan(text.size() + terminator.size());
     state_ = state::idle;
 
-    if (input == terminalpp::detail::ascii::cr)
+    // A paste that is wholly within the input refers to it directly.
+    if (paste_buffer_.empty())
     {
-        return {};
-    }
-    else
-    {
-        return parse_idle(input);
+        return terminalpp::token{terminalpp::paste{text}};
     }
+
+    paste_buffer_.append(text.begin(), text.end());
+    return complete_buffered_paste();
 }
 
-std::optional<terminalpp::token> parser::parse_escape(byte input)
+terminalpp::token parser::complete_buffered_paste()
 {
-    if (input == terminalpp::detail::ascii::esc)
+    // The storage of released pastes is reused, and the paste buffer takes
+    // its place, so that neither allocates once they have grown to fit.
+    if (completed_paste_count_ == completed_pastes_.size())
     {
-        meta_ = true;
+        completed_pastes_.emplace_back();
     }
-    else
-    {
-        initializer_ = input;
-        state_ = state::arguments;
-    }
-    return {};
+
+    auto &completed = completed_pastes_[completed_paste_count_++];
+    completed.swap(paste_buffer_);
+    paste_buffer_.clear();
+
+    return terminalpp::token{terminalpp::paste{completed}};
 }
 
-std::optional<terminalpp::token> parser::parse_arguments(byte input)
+terminalpp::token parser::complete_partial_paste()
 {
-    if (isdigit(input) != 0)  // TODO: depends on initiator.
-    {
-        argument_.push_back(input);
-    }
-    else if (input == terminalpp::ansi::ps)
-    {
-        arguments_.push_back(argument_);
-        argument_ = {};
-    }
-    else if (
-        input == terminalpp::ansi::csi::mouse_tracking
-        && initializer_ == terminalpp::ansi::control7::csi[1])
-    {
-        state_ = state::mouse0;
-    }
-    else if (is_csi_extension_character(input))
+    bytes const terminator{paste_terminator};
+
+    // Since the maximum paste size is at least the size of the terminator,
+    // at least one byte of text is always reported.
+    auto held = (std::min)(terminator.size() - 1, paste_buffer_.size());
+
+    while (held > 0
+           && !std::ranges::equal(
+               bytes{paste_buffer_}.last(held), terminator.first(held)))
     {
-        extender_ = input;
+        --held;
     }
-    else
-    {
-        // construct and return a control sequence.
-        arguments_.push_back(argument_);
-        state_ = state::idle;
 
-        return terminalpp::token{
-            terminalpp::control_sequence{
-                                         initializer_, input, meta_, arguments_, extender_}
-        };
-    }
+    auto const held_bytes = bytes{paste_buffer_}.last(held);
+    byte_storage const tail{held_bytes.begin(), held_bytes.end()};
+    paste_buffer_.resize(paste_buffer_.size() - held);
 
-    return {};
+    auto result = complete_buffered_paste();
+    paste_buffer_.assign(tail);
+    return result;
 }
 
-std::optional<terminalpp::token> parser::parse_mouse0(byte input)
+void parser::release_pastes() noexcept
 {
-    static constexpr struct
-    {
-        byte ansi_mouse_event;
-        mouse::event_type mouse_event;
-    } mouse_event_table[] = {
-        {ansi::mouse::left_button_down,   mouse::event_type::left_button_down },
-        {ansi::mouse::middle_button_down,
-         mouse::event_type::middle_button_down                                },
-        {ansi::mouse::right_button_down,  mouse::event_type::right_button_down},
-        {ansi::mouse::button_up,          mouse::event_type::button_up        },
-        {ansi::mouse::no_button_change,   mouse::event_type::no_button_change },
-        {ansi::mouse::scrollwheel_up,     mouse::event_type::scrollwheel_up   },
-        {ansi::mouse::scrollwheel_down,   mouse::event_type::scrollwheel_down },
+    completed_paste_count_ = 0;
+}
+
+terminalpp::token parser::make_sgr_mouse_event(byte command)
+{
+    static constexpr mouse::button buttons[] = {
+        mouse::button::left,
+        mouse::button::middle,
+        mouse::button::right,
+        mouse::button::none,
+    };
+
+    static constexpr mouse::event_type press_events[] = {
+        mouse::event_type::left_button_down,
+        mouse::event_type::middle_button_down,
+        mouse::event_type::right_button_down,
+        mouse::event_type::button_up,
+    };
+
+    static constexpr mouse::event_type wheel_events[] = {
+        mouse::event_type::scrollwheel_up,
+        mouse::event_type::scrollwheel_down,
+        mouse::event_type::no_button_change,
+        mouse::event_type::no_button_change,
+    };
+
+    static constexpr std::pair<byte, vk_modifier> modifiers[] = {
+        {ansi::mouse::shift_mask, vk_modifier::shift},
+        {ansi::mouse::meta_mask,  vk_modifier::meta },
+        {ansi::mouse::ctrl_mask,  vk_modifier::ctrl },
+    };
+
+    parameters_.end_parameter();
+
+    auto const code = parameters_.get_or(0, 0);
+    auto const button_index = code & ansi::mouse::button_mask;
+
+    // SGR co-ordinates are 1-based, whereas Terminal++ is 0-based.
+    auto const coordinate = [this](std::size_t index) {
+        auto const value = (std::max)(parameters_.get_or(index, 1), 1U) - 1;
+        return static_cast<coordinate_type>((std::min)(
+            value,
+            static_cast<control_sequence_parameters::value_type>(
+                (std::numeric_limits<coordinate_type>::max)())));
     };
 
-    if (auto const *result = std::ranges::find(
-            mouse_event_table,
-            input - ansi::mouse::mouse_value_offset,
-            [](auto const &entry) { return entry.ansi_mouse_event; });
-        result != std::cend(mouse_event_table))
+    mouse::event event{
+        .position_ = {coordinate(1), coordinate(2)},
+        .button_ = buttons[button_index],
+    };
+
+    for (auto const &[mask, modifier] : modifiers)
+    {
+        if ((code & mask) != 0)
+        {
+            event.modifiers_ |= modifier;
+        }
+    }
+
+    if ((code & ansi::mouse::wheel_mask) != 0)
+    {
+        event.action_ = wheel_events[button_index];
+        event.button_ = mouse::button::none;
+    }
+    else if (command == ansi::mouse::sgr_release)
     {
-        mouse_event_type_ = result->mouse_event;
+        event.action_ = mouse::event_type::button_up;
+    }
+    else if ((code & ansi::mouse::motion_mask) != 0)
+    {
+        event.action_ = mouse::event_type::no_button_change;
     }
     else
     {
-        mouse_event_type_ = mouse::event_type::no_button_change;
+        event.action_ = press_events[button_index];
     }
 
-    state_ = state::mouse1;
-    return {};
+    return terminalpp::token{event};
 }
 
-std::optional<terminalpp::token> parser::parse_mouse1(byte input)
+std::size_t parser::ordinary_run_length(bytes input) noexcept
 {
-    // In addition to the offset described above, ANSI co-ordinates are
-    // 1-based, whereas Terminal++ is 0-based, which means an extra offset
-    // is required.
-    mouse_coordinate_.x_ = static_cast<coordinate_type>(
-        (input - ansi::mouse::mouse_value_offset) - 1);
-    state_ = state::mouse2;
-
-    return {};
+    return static_cast<std::size_t>(
+        std::ranges::find_if(
+            input, [](byte ch) { return !tables::ordinary_idle_bytes[ch]; })
+        - input.begin());
 }
 
-std::optional<terminalpp::token> parser::parse_mouse2(byte input)
+terminalpp::token parser::make_ordinary_key(byte input)
 {
-    mouse_coordinate_.y_ = static_cast<coordinate_type>(
-        (input - ansi::mouse::mouse_value_offset) - 1);
-    state_ = state::idle;
-
-    return {terminalpp::token{
-        terminalpp::mouse::event{mouse_event_type_, mouse_coordinate_}}};
+    return terminalpp::token{
+        terminalpp::virtual_key{
+                                static_cast<vk>(input),
+                                terminalpp::vk_modifier::none,
+                                1, {input}}
+    };
 }
 
 }  // namespace terminalpp::detail
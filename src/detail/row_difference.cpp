@@ -0,0 +1,241 @@
+#include "terminalpp/detail/row_difference.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define TERMINALPP_ROW_DIFFERENCE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined(TERMINALPP_ROW_DIFFERENCE_SSE2) \
+    && (defined(__GNUC__) || defined(__clang__))
+#define TERMINALPP_ROW_DIFFERENCE_AVX2 1
+#include <immintrin.h>
+#endif
+
+namespace terminalpp::detail {
+
+namespace {
+
+// A function that returns the offset of the first byte that differs between
+// lhs and rhs, or size if they are identical.
+using byte_difference_function =
+    std::size_t (*)(byte const *lhs, byte const *rhs, std::size_t size);
+
+// ==========================================================================
+// FIRST_BYTE_DIFFERENCE_SCALAR
+// ==========================================================================
+std::size_t first_byte_difference_scalar(
+    byte const *lhs, byte const *rhs, std::size_t size)
+{
+    std::size_t offset = 0;
+
+    // Compare a word at a time until a word differs.
+    for (; offset + sizeof(std::uint64_t) <= size;
+         offset += sizeof(std::uint64_t))
+    {
+        std::uint64_t lhs_word = 0;
+        std::uint64_t rhs_word = 0;
+        std::memcpy(&lhs_word, lhs + offset, sizeof(lhs_word));
+        std::memcpy(&rhs_word, rhs + offset, sizeof(rhs_word));
+
+        if (lhs_word != rhs_word)
+        {
+            break;
+        }
+    }
+
+    return static_cast<std::size_t>(
+        std::mismatch(lhs + offset, lhs + size, rhs + offset).first - lhs);
+}
+
+#if defined(TERMINALPP_ROW_DIFFERENCE_SSE2)
+// ==========================================================================
+// FIRST_BYTE_DIFFERENCE_SSE2
+// ==========================================================================
+std::size_t first_byte_difference_sse2(
+    byte const *lhs, byte const *rhs, std::size_t size)
+{
+    constexpr std::size_t block_size = sizeof(__m128i);
+    constexpr unsigned int all_equal = 0xFFFFU;
+    std::size_t offset = 0;
+
+    for (; offset + block_size <= size; offset += block_size)
+    {
+        auto const lhs_block = _mm_loadu_si128(
+            reinterpret_cast<__m128i const *>(lhs + offset));  // NOLINT
+        auto const rhs_block = _mm_loadu_si128(
+            reinterpret_cast<__m128i const *>(rhs + offset));  // NOLINT
+        auto const mask = static_cast<unsigned int>(
+            _mm_movemask_epi8(_mm_cmpeq_epi8(lhs_block, rhs_block)));
+
+        if (mask != all_equal)
+        {
+            return offset + static_cast<std::size_t>(std::countr_one(mask));
+        }
+    }
+
+    return offset
+         + first_byte_difference_scalar(
+               lhs + offset, rhs + offset, size - offset);
+}
+#endif
+
+#if defined(TERMINALPP_ROW_DIFFERENCE_AVX2)
+// ==========================================================================
+// FIRST_BYTE_DIFFERENCE_AVX2
+// ==========================================================================
+__attribute__((target("avx2"))) std::size_t first_byte_difference_avx2(
+    byte const *lhs, byte const *rhs, std::size_t size)
+{
+    constexpr std::size_t block_size = sizeof(__m256i);
+    constexpr std::uint32_t all_equal = 0xFFFF'FFFFU;
+    std::size_t offset = 0;
+
+    for (; offset + block_size <= size; offset += block_size)
+    {
+        auto const lhs_block = _mm256_loadu_si256(
+            reinterpret_cast<__m256i const *>(lhs + offset));  // NOLINT
+        auto const rhs_block = _mm256_loadu_si256(
+            reinterpret_cast<__m256i const *>(rhs + offset));  // NOLINT
+        auto const mask = static_cast<std::uint32_t>(
+            _mm256_movemask_epi8(_mm256_cmpeq_epi8(lhs_block, rhs_block)));
+
+        if (mask != all_equal)
+        {
+            return offset + static_cast<std::size_t>(std::countr_one(mask));
+        }
+    }
+
+    return offset
+         + first_byte_difference_sse2(
+               lhs + offset, rhs + offset, size - offset);
+}
+#endif
+
+// ==========================================================================
+// BYTE_DIFFERENCE_FUNCTION_FOR
+// ==========================================================================
+byte_difference_function byte_difference_function_for(
+    row_difference_kernel kernel)
+{
+    switch (kernel)
+    {
+#if defined(TERMINALPP_ROW_DIFFERENCE_AVX2)
+        case row_difference_kernel::avx2:
+            return first_byte_difference_avx2;
+#endif
+
+#if defined(TERMINALPP_ROW_DIFFERENCE_SSE2)
+        case row_difference_kernel::sse2:
+            return first_byte_difference_sse2;
+#endif
+
+        default:
+            return first_byte_difference_scalar;
+    }
+}
+
+}  // namespace
+
+// ==========================================================================
+// IS_SUPPORTED
+// ==========================================================================
+bool is_supported(row_difference_kernel kernel) noexcept
+{
+    switch (kernel)
+    {
+#if defined(TERMINALPP_ROW_DIFFERENCE_AVX2)
+        case row_difference_kernel::avx2:
+            return __builtin_cpu_supports("avx2") != 0;
+#endif
+
+#if defined(TERMINALPP_ROW_DIFFERENCE_SSE2)
+        case row_difference_kernel::sse2:
+            // SSE2 is part of the baseline x86-64 instruction set.
+            return true;
+#endif
+
+        case row_difference_kernel::scalar:
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+// ==========================================================================
+// SELECT_ROW_DIFFERENCE_KERNEL
+// ==========================================================================
+row_difference_kernel select_row_difference_kernel() noexcept
+{
+    static auto const selected_kernel = [] {
+        for (auto const kernel :
+             {row_difference_kernel::avx2, row_difference_kernel::sse2})
+        {
+            if (is_supported(kernel))
+            {
+                return kernel;
+            }
+        }
+
+        return row_difference_kernel::scalar;
+    }();
+
+    return selected_kernel;
+}
+
+// ==========================================================================
+// FIND_FIRST_DIFFERENCE
+// ==========================================================================
+std::size_t find_first_difference(
+    std::span<element const> lhs, std::span<element const> rhs) noexcept
+{
+    return find_first_difference(select_row_difference_kernel(), lhs, rhs);
+}
+
+// ==========================================================================
+// FIND_FIRST_DIFFERENCE
+// ==========================================================================
+std::size_t find_first_difference(
+    row_difference_kernel kernel,
+    std::span<element const> lhs,
+    std::span<element const> rhs) noexcept
+{
+    auto const first_byte_difference = byte_difference_function_for(kernel);
+    auto const size = (std::min)(lhs.size(), rhs.size());
+    auto const *const lhs_bytes =
+        reinterpret_cast<byte const *>(lhs.data());  // NOLINT
+    auto const *const rhs_bytes =
+        reinterpret_cast<byte const *>(rhs.data());  // NOLINT
+
+    std::size_t index = 0;
+
+    while (index < size)
+    {
+        auto const offset = index * sizeof(element);
+
+        index += first_byte_difference(
+                     lhs_bytes + offset,
+                     rhs_bytes + offset,
+                     (size - index) * sizeof(element))
+               / sizeof(element);
+
+        // Elements whose bytes differ may still be equal, since not every
+        // byte of an element contributes to its value (e.g. the unused
+        // bytes of a glyph that is not UTF-8).
+        if (index == size || lhs[index] != rhs[index])
+        {
+            break;
+        }
+
+        ++index;
+    }
+
+    return index;
+}
+
+}  // namespace terminalpp::detail
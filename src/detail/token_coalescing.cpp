@@ -0,0 +1,195 @@
+#include "terminalpp/detail/token_coalescing.hpp"
+
+#include <iterator>
+#include <limits>
+#include <utility>
+
+namespace terminalpp::detail {
+
+namespace {
+
+// ==========================================================================
+// COALESCE
+// ==========================================================================
+// Compacts the tokens in place.  Each token is offered to merge along with
+// the last token kept; if merge absorbs it into that token, then it is
+// dropped, otherwise it is kept after it.
+template <class Merge>
+void coalesce(terminalpp::token_storage &tokens, Merge &&merge)
+{
+    auto kept = tokens.begin();
+
+    for (auto current = tokens.begin(); current != tokens.end(); ++current)
+    {
+        if (kept == tokens.begin() || !merge(*std::prev(kept), *current))
+        {
+            if (kept != current)
+            {
+                *kept = std::move(*current);
+            }
+
+            ++kept;
+        }
+    }
+
+    tokens.erase(kept, tokens.end());
+}
+
+// ==========================================================================
+// IS_CONTINUED_MOTION
+// ==========================================================================
+// Returns true if the current event continues the motion of the kept event.
+bool is_continued_motion(
+    mouse::event const &kept, mouse::event const &current)
+{
+    return kept.action_ == mouse::event_type::no_button_change
+        && current.action_ == mouse::event_type::no_button_change
+        && kept.button_ == current.button_
+        && kept.modifiers_ == current.modifiers_;
+}
+
+// ==========================================================================
+// REPEAT_COUNT_WOULD_OVERFLOW
+// ==========================================================================
+// Returns true if adding the repeat counts would overflow, in which case
+// the keys are kept separate rather than losing any of their repeats.
+constexpr bool repeat_count_would_overflow(int lhs, int rhs)
+{
+    return rhs > 0 ? lhs > (std::numeric_limits<int>::max)() - rhs
+                   : lhs < (std::numeric_limits<int>::min)() - rhs;
+}
+
+// ==========================================================================
+// IS_REPEATED_KEY
+// ==========================================================================
+// Returns true if the current key repeats the kept key (which may be in
+// either full or compact form), not counting their input sequences.
+template <class Key>
+bool is_repeated_key(Key const &kept, virtual_key const &current)
+{
+    return kept.key == current.key && kept.modifiers == current.modifiers
+        && !repeat_count_would_overflow(
+               kept.repeat_count, current.repeat_count);
+}
+
+// ==========================================================================
+// HAS_INPUT_SEQUENCE
+// ==========================================================================
+// Returns true if the compact key in the batch was generated by the given
+// input sequence.
+bool has_input_sequence(
+    token_batch const &batch,
+    compact_virtual_key const &key,
+    virtual_key::input_sequence const &sequence)
+{
+    if (key.sequence == compact_virtual_key::no_sequence)
+    {
+        auto const *const character = std::get_if<byte>(&sequence);
+        return character != nullptr && *character == key.character;
+    }
+
+    auto const *const seq = std::get_if<control_sequence>(&sequence);
+    return seq != nullptr && *seq == batch.sequence(key.sequence);
+}
+
+// ==========================================================================
+// MERGE_MOTION
+// ==========================================================================
+template <class Token>
+bool merge_motion(Token &kept, terminalpp::token const &current)
+{
+    auto *const kept_event = std::get_if<mouse::event>(&kept);
+    auto const *const current_event = std::get_if<mouse::event>(&current);
+
+    if (kept_event != nullptr && current_event != nullptr
+        && is_continued_motion(*kept_event, *current_event))
+    {
+        kept_event->position_ = current_event->position_;
+        return true;
+    }
+
+    return false;
+}
+
+// ==========================================================================
+// MERGE_KEY_REPEAT
+// ==========================================================================
+bool merge_key_repeat(terminalpp::token &kept, terminalpp::token const &current)
+{
+    auto *const kept_key = std::get_if<virtual_key>(&kept);
+    auto const *const current_key = std::get_if<virtual_key>(&current);
+
+    if (kept_key != nullptr && current_key != nullptr
+        && is_repeated_key(*kept_key, *current_key)
+        && kept_key->sequence == current_key->sequence)
+    {
+        kept_key->repeat_count += current_key->repeat_count;
+        return true;
+    }
+
+    return false;
+}
+
+// ==========================================================================
+// MERGE_KEY_REPEAT
+// ==========================================================================
+bool merge_key_repeat(
+    token_batch const &batch,
+    compact_token &kept,
+    terminalpp::token const &current)
+{
+    auto *const kept_key = std::get_if<compact_virtual_key>(&kept);
+    auto const *const current_key = std::get_if<virtual_key>(&current);
+
+    if (kept_key != nullptr && current_key != nullptr
+        && is_repeated_key(*kept_key, *current_key)
+        && has_input_sequence(batch, *kept_key, current_key->sequence))
+    {
+        kept_key->repeat_count += current_key->repeat_count;
+        return true;
+    }
+
+    return false;
+}
+
+}  // namespace
+
+// ==========================================================================
+// COALESCE_MOUSE_MOTION
+// ==========================================================================
+void coalesce_mouse_motion(terminalpp::token_storage &tokens)
+{
+    coalesce(tokens, merge_motion<terminalpp::token>);
+}
+
+// ==========================================================================
+// COALESCE_KEY_REPEATS
+// ==========================================================================
+void coalesce_key_repeats(terminalpp::token_storage &tokens)
+{
+    coalesce(tokens, [](terminalpp::token &kept, terminalpp::token &current) {
+        return merge_key_repeat(kept, current);
+    });
+}
+
+// ==========================================================================
+// MERGE_INTO_LAST
+// ==========================================================================
+bool merge_into_last(
+    token_batch &batch,
+    terminalpp::token const &tok,
+    bool mouse_motion,
+    bool key_repeats)
+{
+    if (batch.empty())
+    {
+        return false;
+    }
+
+    auto &last = batch.back();
+
+    return (mouse_motion && merge_motion(last, tok))
+        || (key_repeats && merge_key_repeat(batch, last, tok));
+}
+
+}  // namespace terminalpp::detail
@@ -3,247 +3,253 @@
 #include "terminalpp/ansi/control_characters.hpp"
 #include "terminalpp/ansi/csi.hpp"
 #include "terminalpp/ansi/ss3.hpp"
-#include "terminalpp/detail/overloaded.hpp"
 
 #include <algorithm>
+#include <array>
+#include <limits>
+#include <optional>
 #include <utility>
 #include <cassert>
 
-using namespace terminalpp::literals;  // NOLINT
-
 namespace terminalpp::detail {
 
 namespace {
 
-vk_modifier convert_modifier_argument(byte_storage const &modifier)
-{
-    static constexpr std::pair<byte, vk_modifier> modifier_mappings[] = {
+// Modifiers are delivered as the second argument of a sequence, as a number
+// designating the combination of modifier keys held.
+constexpr std::pair<byte, vk_modifier> modifier_mappings[] = {
   // clang-format off
-        { ansi::csi::modifier_shift,               vk_modifier::shift },
-        { ansi::csi::modifier_ctrl,                vk_modifier::ctrl  },
-        { ansi::csi::modifier_alt,                 vk_modifier::alt   },
-        { ansi::csi::modifier_meta,                vk_modifier::meta  },
-
-        { ansi::csi::modifier_shift_alt,           vk_modifier::shift
-                                                 | vk_modifier::alt   },
-        { ansi::csi::modifier_shift_ctrl,          vk_modifier::shift
-                                                 | vk_modifier::ctrl  },
-        { ansi::csi::modifier_alt_ctrl,            vk_modifier::alt
-                                                 | vk_modifier::ctrl  },
-        { ansi::csi::modifier_shift_alt_ctrl,      vk_modifier::shift
-                                                 | vk_modifier::alt
-                                                 | vk_modifier::ctrl  },
-
-        { ansi::csi::modifier_meta_shift,          vk_modifier::meta
-                                                 | vk_modifier::shift },
-        { ansi::csi::modifier_meta_ctrl,           vk_modifier::meta
-                                                 | vk_modifier::ctrl  },
-        { ansi::csi::modifier_meta_alt,            vk_modifier::meta
-                                                 | vk_modifier::alt   },
-
-        { ansi::csi::modifier_meta_shift_alt,      vk_modifier::meta
-                                                 | vk_modifier::shift
-                                                 | vk_modifier::alt   },
-        { ansi::csi::modifier_meta_shift_ctrl,     vk_modifier::meta
-                                                 | vk_modifier::shift
-                                                 | vk_modifier::ctrl  },
-        { ansi::csi::modifier_meta_alt_ctrl,       vk_modifier::meta
-                                                 | vk_modifier::alt
-                                                 | vk_modifier::ctrl  },
-        { ansi::csi::modifier_meta_shift_alt_ctrl, vk_modifier::meta
-                                                 | vk_modifier::shift
-                                                 | vk_modifier::alt
-                                                 | vk_modifier::ctrl  },
+    { ansi::csi::modifier_shift,               vk_modifier::shift },
+    { ansi::csi::modifier_ctrl,                vk_modifier::ctrl  },
+    { ansi::csi::modifier_alt,                 vk_modifier::alt   },
+    { ansi::csi::modifier_meta,                vk_modifier::meta  },
+
+    { ansi::csi::modifier_shift_alt,           vk_modifier::shift
+                                             | vk_modifier::alt   },
+    { ansi::csi::modifier_shift_ctrl,          vk_modifier::shift
+                                             | vk_modifier::ctrl  },
+    { ansi::csi::modifier_alt_ctrl,            vk_modifier::alt
+                                             | vk_modifier::ctrl  },
+    { ansi::csi::modifier_shift_alt_ctrl,      vk_modifier::shift
+                                             | vk_modifier::alt
+                                             | vk_modifier::ctrl  },
+
+    { ansi::csi::modifier_meta_shift,          vk_modifier::meta
+                                             | vk_modifier::shift },
+    { ansi::csi::modifier_meta_ctrl,           vk_modifier::meta
+                                             | vk_modifier::ctrl  },
+    { ansi::csi::modifier_meta_alt,            vk_modifier::meta
+                                             | vk_modifier::alt   },
+
+    { ansi::csi::modifier_meta_shift_alt,      vk_modifier::meta
+                                             | vk_modifier::shift
+                                             | vk_modifier::alt   },
+    { ansi::csi::modifier_meta_shift_ctrl,     vk_modifier::meta
+                                             | vk_modifier::shift
+                                             | vk_modifier::ctrl  },
+    { ansi::csi::modifier_meta_alt_ctrl,       vk_modifier::meta
+                                             | vk_modifier::alt
+                                             | vk_modifier::ctrl  },
+    { ansi::csi::modifier_meta_shift_alt_ctrl, vk_modifier::meta
+                                             | vk_modifier::shift
+                                             | vk_modifier::alt
+                                             | vk_modifier::ctrl  },
   // clang-format on
-    };
-
-    auto const value = atoi(reinterpret_cast<char const *>(modifier.c_str()));
-    if (auto const *mapping = std::ranges::find(
-            modifier_mappings,
-            value,
-            [](auto const &inner_mapping) { return inner_mapping.first; });
-        mapping != end(modifier_mappings))
-    {
-        return mapping->second;
-    }
-    else
+};
+
+// Cursor Movement commands are in the form "ESC [ C" where C is some letter
+// indicating the direction in which to move.
+constexpr std::pair<byte, vk> const cursor_movement_commands[] = {
+  // clang-format off
+    { ansi::csi::cursor_up,                  vk::cursor_up    },
+    { ansi::csi::cursor_down,                vk::cursor_down  },
+    { ansi::csi::cursor_forward,             vk::cursor_right },
+    { ansi::csi::cursor_backward,            vk::cursor_left  },
+    { ansi::csi::cursor_home,                vk::home         },
+    { ansi::csi::cursor_end,                 vk::end          },
+    { ansi::csi::cursor_tabulation,          vk::ht           },
+    { ansi::csi::cursor_backward_tabulation, vk::bt           },
+  // clang-format on
+};
+
+// SS3 commands are delivered as "ESC O C" where C is a letter designating
+// the command to perform.
+constexpr std::pair<byte, vk> const ss3_commands[] = {
+  // clang-format off
+    { ansi::ss3::cursor_up,    vk::cursor_up    },
+    { ansi::ss3::cursor_down,  vk::cursor_down  },
+    { ansi::ss3::cursor_right, vk::cursor_right },
+    { ansi::ss3::cursor_left,  vk::cursor_left  },
+    { ansi::ss3::cursor_home,  vk::home         },
+    { ansi::ss3::cursor_end,   vk::end          },
+    { ansi::ss3::cursor_tab,   vk::ht           },
+    { ansi::ss3::enter,        vk::enter        },
+    { ansi::ss3::f1,           vk::f1           },
+    { ansi::ss3::f2,           vk::f2           },
+    { ansi::ss3::f3,           vk::f3           },
+    { ansi::ss3::f4,           vk::f4           },
+  // clang-format on
+};
+
+// Keypad commands are delivered as "ESC [ N ~" where N is a number
+// designating the key pressed.
+constexpr std::pair<byte, vk> const keypad_commands[] = {
+  // clang-format off
+    { ansi::csi::keypad_home,   vk::home },
+    { ansi::csi::keypad_insert, vk::ins  },
+    { ansi::csi::keypad_del,    vk::del  },
+    { ansi::csi::keypad_end,    vk::end  },
+    { ansi::csi::keypad_pgup,   vk::pgup },
+    { ansi::csi::keypad_pgdn,   vk::pgdn },
+    { ansi::csi::keypad_f1,     vk::f1   },
+    { ansi::csi::keypad_f2,     vk::f2   },
+    { ansi::csi::keypad_f3,     vk::f3   },
+    { ansi::csi::keypad_f4,     vk::f4   },
+    { ansi::csi::keypad_f5,     vk::f5   },
+    { ansi::csi::keypad_f6,     vk::f6   },
+    { ansi::csi::keypad_f7,     vk::f7   },
+    { ansi::csi::keypad_f8,     vk::f8   },
+    { ansi::csi::keypad_f9,     vk::f9   },
+    { ansi::csi::keypad_f10,    vk::f10  },
+    { ansi::csi::keypad_f11,    vk::f11  },
+    { ansi::csi::keypad_f12,    vk::f12  },
+  // clang-format on
+};
+
+// Builds a table of the given size that maps each key of the mappings
+// directly to its value, so that lookups need not search the mappings.
+template <std::size_t Size, class Value, std::size_t Count>
+constexpr auto make_lookup_table(
+    std::pair<byte, Value> const (&mappings)[Count])
+{
+    std::array<std::optional<Value>, Size> table{};
+
+    for (auto const &[key, value] : mappings)
     {
-        return vk_modifier::none;
+        table[key] = value;
     }
+
+    return table;
 }
 
-token convert_control_sequence(control_sequence const &seq)
+// Returns the value for the key in a table built by make_lookup_table, if
+// there is one.
+template <class Value, std::size_t Size>
+constexpr std::optional<Value> lookup(
+    std::array<std::optional<Value>, Size> const &table, std::size_t key)
 {
-    // Cursor Movement commands are in the form "ESC [ C" where C is some
-    // letter indicating the direction in which to move.
-    static constexpr std::pair<byte, vk> const cursor_movement_commands[] = {
-  // clang-format off
-        { ansi::csi::cursor_up,                  vk::cursor_up    },
-        { ansi::csi::cursor_down,                vk::cursor_down  },
-        { ansi::csi::cursor_forward,             vk::cursor_right },
-        { ansi::csi::cursor_backward,            vk::cursor_left  },
-        { ansi::csi::cursor_home,                vk::home         },
-        { ansi::csi::cursor_end,                 vk::end          },
-        { ansi::csi::cursor_tabulation,          vk::ht           },
-        { ansi::csi::cursor_backward_tabulation, vk::bt           },
-  // clang-format on
-    };
+    return key < table.size() ? table[key] : std::nullopt;
+}
 
-    assert(seq.initiator == ansi::control7::csi[1]);
+constexpr auto modifier_table =
+    make_lookup_table<ansi::csi::modifier_meta_shift_alt_ctrl + 1>(
+        modifier_mappings);
 
-    auto const &cursor_movement_command = std::ranges::find(
-        cursor_movement_commands, seq.command, [](auto const &elem) {
-            return elem.first;
-        });
+constexpr auto cursor_movement_table =
+    make_lookup_table<256>(cursor_movement_commands);
 
-    if (cursor_movement_command != end(cursor_movement_commands))
-    {
-        auto const repeat_count_arg =
-            seq.arguments.empty() ? "1"_tb : seq.arguments[0];
+constexpr auto ss3_table = make_lookup_table<256>(ss3_commands);
+
+constexpr auto keypad_table =
+    make_lookup_table<ansi::csi::keypad_f12 + 1>(keypad_commands);
 
-        auto const repeat_count = std::max(
-            atoi(reinterpret_cast<char const *>(repeat_count_arg.c_str())), 1);
+vk_modifier convert_modifier_parameter(
+    control_sequence_parameters::value_type modifier)
+{
+    return lookup(modifier_table, modifier).value_or(vk_modifier::none);
+}
+
+token convert_control_sequence(
+    control_sequence &&seq, control_sequence_parameters const &parameters)
+{
+    assert(seq.initiator == ansi::control7::csi[1]);
+
+    if (auto const cursor_movement_command =
+            lookup(cursor_movement_table, seq.command);
+        cursor_movement_command.has_value())
+    {
+        auto const repeat_count = static_cast<int>(std::clamp(
+            parameters.get_or(0, 1),
+            control_sequence_parameters::value_type{1},
+            control_sequence_parameters::value_type{
+                (std::numeric_limits<int>::max)()}));
 
         vk_modifier const modifier =
-            (seq.arguments.size() > 1
-                 ? convert_modifier_argument(seq.arguments[1])
-                 : vk_modifier::none)
+            convert_modifier_parameter(parameters.get_or(1, 0))
             | (seq.meta ? vk_modifier::meta : vk_modifier::none);
 
         return virtual_key{
-            cursor_movement_command->second, modifier, repeat_count, seq};
+            *cursor_movement_command, modifier, repeat_count, std::move(seq)};
     }
 
     return seq;
 }
 
-token convert_ss3_sequence(control_sequence const &seq)
+token convert_ss3_sequence(control_sequence &&seq)
 {
-    // SS3 commands are delivered as "ESC O C" where C is a letter designating
-    // the command to perform.
-    static constexpr std::pair<byte, vk> const ss3_commands[] = {
-  // clang-format off
-        { ansi::ss3::cursor_up,    vk::cursor_up    },
-        { ansi::ss3::cursor_down,  vk::cursor_down  },
-        { ansi::ss3::cursor_right, vk::cursor_right },
-        { ansi::ss3::cursor_left,  vk::cursor_left  },
-        { ansi::ss3::cursor_home,  vk::home         },
-        { ansi::ss3::cursor_end,   vk::end          },
-        { ansi::ss3::cursor_tab,   vk::ht           },
-        { ansi::ss3::enter,        vk::enter        },
-        { ansi::ss3::f1,           vk::f1           },
-        { ansi::ss3::f2,           vk::f2           },
-        { ansi::ss3::f3,           vk::f3           },
-        { ansi::ss3::f4,           vk::f4           },
-  // clang-format on
-    };
-
     assert(seq.initiator == ansi::control7::ss3[1]);
 
-    if (auto const *ss3_command = std::ranges::find(
-            ss3_commands,
-            seq.command,
-            [](auto const &elem) { return elem.first; });
-        ss3_command != std::cend(ss3_commands))
+    if (auto const ss3_command = lookup(ss3_table, seq.command);
+        ss3_command.has_value())
     {
         vk_modifier const modifier =
             seq.meta ? vk_modifier::meta : vk_modifier::none;
 
-        return virtual_key{ss3_command->second, modifier, 1, seq};
+        return virtual_key{*ss3_command, modifier, 1, std::move(seq)};
     }
 
     return seq;
 }
 
-token convert_keypad_sequence(control_sequence const &seq)
+token convert_keypad_sequence(
+    control_sequence &&seq, control_sequence_parameters const &parameters)
 {
-    // Keypad commands are delivered as "ESC [ N ~" where N is a number
-    // designating the key pressed.
-    static constexpr std::pair<char, vk> const keypad_commands[] = {
-  // clang-format off
-        { ansi::csi::keypad_home,   vk::home },
-        { ansi::csi::keypad_insert, vk::ins  },
-        { ansi::csi::keypad_del,    vk::del  },
-        { ansi::csi::keypad_end,    vk::end  },
-        { ansi::csi::keypad_pgup,   vk::pgup },
-        { ansi::csi::keypad_pgdn,   vk::pgdn },
-        { ansi::csi::keypad_f1,     vk::f1   },
-        { ansi::csi::keypad_f2,     vk::f2   },
-        { ansi::csi::keypad_f3,     vk::f3   },
-        { ansi::csi::keypad_f4,     vk::f4   },
-        { ansi::csi::keypad_f5,     vk::f5   },
-        { ansi::csi::keypad_f6,     vk::f6   },
-        { ansi::csi::keypad_f7,     vk::f7   },
-        { ansi::csi::keypad_f8,     vk::f8   },
-        { ansi::csi::keypad_f9,     vk::f9   },
-        { ansi::csi::keypad_f10,    vk::f10  },
-        { ansi::csi::keypad_f11,    vk::f11  },
-        { ansi::csi::keypad_f12,    vk::f12  },
-  // clang-format on
-    };
-
     assert(seq.command == ansi::csi::keypad_function);
 
-    if (seq.arguments[0].empty() || (isdigit(seq.arguments[0][0]) == 0))
+    auto const argument = parameters.get(0);
+
+    if (!argument.has_value())
     {
         // Nothing will match.
         return seq;
     }
 
-    auto const argument =
-        atoi(reinterpret_cast<char const *>(seq.arguments[0].c_str()));
-
-    if (auto const *keypad_command = std::ranges::find(
-            keypad_commands,
-            argument,
-            [](auto const &elem) { return elem.first; });
-        keypad_command != std::cend(keypad_commands))
+    if (auto const keypad_command = lookup(keypad_table, *argument);
+        keypad_command.has_value())
     {
         vk_modifier const modifier =
-            (seq.arguments.size() > 1
-                 ? convert_modifier_argument(seq.arguments[1])
-                 : vk_modifier::none)
+            convert_modifier_parameter(parameters.get_or(1, 0))
             | (seq.meta ? vk_modifier::meta : vk_modifier::none);
 
-        return virtual_key{keypad_command->second, modifier, 1, seq};
+        return virtual_key{*keypad_command, modifier, 1, std::move(seq)};
     }
 
     return seq;
 }
 
-token convert_common_control_sequence(control_sequence const &seq)
+}  // namespace
+
+// ==========================================================================
+// GET_WELL_KNOWN_VIRTUAL_KEY
+// ==========================================================================
+token get_well_known_virtual_key(
+    control_sequence seq, control_sequence_parameters const &parameters)
 {
     if (seq.initiator == ansi::control7::csi[1])
     {
         if (seq.command == ansi::csi::keypad_function)
         {
-            return convert_keypad_sequence(seq);
+            return convert_keypad_sequence(std::move(seq), parameters);
         }
 
-        return convert_control_sequence(seq);
+        return convert_control_sequence(std::move(seq), parameters);
     }
     else if (seq.initiator == ansi::control7::ss3[1])
     {
-        return convert_ss3_sequence(seq);
+        return convert_ss3_sequence(std::move(seq));
     }
 
     return seq;
 }
 
-}  // namespace
-
-// ==========================================================================
-// GET_WELL_KNOWN_VIRTUAL_KEY
-// ==========================================================================
-token get_well_known_virtual_key(token const &orig)
-{
-    return std::visit(
-        overloaded{
-            [](control_sequence const &seq) {
-                return convert_common_control_sequence(seq);
-            },
-            [](auto &&t) -> token { return t; }},
-        orig);
-}
-
 }  // namespace terminalpp::detail
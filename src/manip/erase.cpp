@@ -9,7 +9,7 @@ namespace terminalpp {
 void erase_display::operator()(
     terminalpp::behaviour const &beh,
     terminalpp::terminal_state &state,
-    terminal::write_function const &write_fn) const
+    write_continuation write_fn) const
 {
     detail::change_to_default_attribute(state.last_element_, beh, write_fn);
     detail::csi(beh, write_fn);
@@ -19,7 +19,7 @@ void erase_display::operator()(
         ansi::csi::erase_in_display,
     };
 
-    write_fn(erase_all_suffix);
+    detail::write_static(write_fn, erase_all_suffix);
 }
 
 // ==========================================================================
@@ -28,7 +28,7 @@ void erase_display::operator()(
 void erase_display_above::operator()(
     terminalpp::behaviour const &beh,
     terminalpp::terminal_state &state,
-    terminal::write_function const &write_fn) const
+    write_continuation write_fn) const
 {
     detail::change_to_default_attribute(state.last_element_, beh, write_fn);
     detail::csi(beh, write_fn);
@@ -38,7 +38,7 @@ void erase_display_above::operator()(
         ansi::csi::erase_in_display,
     };
 
-    write_fn(erase_above_suffix);
+    detail::write_static(write_fn, erase_above_suffix);
 }
 
 // ==========================================================================
@@ -47,7 +47,7 @@ void erase_display_above::operator()(
 void erase_display_below::operator()(
     terminalpp::behaviour const &beh,
     terminalpp::terminal_state &state,
-    terminal::write_function const &write_fn) const
+    write_continuation write_fn) const
 {
     detail::change_to_default_attribute(state.last_element_, beh, write_fn);
     detail::csi(beh, write_fn);
@@ -57,7 +57,7 @@ void erase_display_below::operator()(
         ansi::csi::erase_in_display,
     };
 
-    write_fn(erase_below_suffix);
+    detail::write_static(write_fn, erase_below_suffix);
 }
 
 // ==========================================================================
@@ -66,7 +66,7 @@ void erase_display_below::operator()(
 void erase_line::operator()(
     terminalpp::behaviour const &beh,
     terminalpp::terminal_state &state,
-    terminal::write_function const &write_fn) const
+    write_continuation write_fn) const
 {
     detail::change_to_default_attribute(state.last_element_, beh, write_fn);
     detail::csi(beh, write_fn);
@@ -76,7 +76,7 @@ void erase_line::operator()(
         ansi::csi::erase_in_line,
     };
 
-    write_fn(erase_line_suffix);
+    detail::write_static(write_fn, erase_line_suffix);
 }
 
 // ==========================================================================
@@ -85,7 +85,7 @@ void erase_line::operator()(
 void erase_line_left::operator()(
     terminalpp::behaviour const &beh,
     terminalpp::terminal_state &state,
-    terminal::write_function const &write_fn) const
+    write_continuation write_fn) const
 {
     detail::change_to_default_attribute(state.last_element_, beh, write_fn);
     detail::csi(beh, write_fn);
@@ -95,7 +95,7 @@ void erase_line_left::operator()(
         ansi::csi::erase_in_line,
     };
 
-    write_fn(erase_line_left_suffix);
+    detail::write_static(write_fn, erase_line_left_suffix);
 }
 
 // ==========================================================================
@@ -104,7 +104,7 @@ void erase_line_left::operator()(
 void erase_line_right::operator()(
     terminalpp::behaviour const &beh,
     terminalpp::terminal_state &state,
-    terminal::write_function const &write_fn) const
+    write_continuation write_fn) const
 {
     detail::change_to_default_attribute(state.last_element_, beh, write_fn);
     detail::csi(beh, write_fn);
@@ -114,7 +114,7 @@ void erase_line_right::operator()(
         ansi::csi::erase_in_line,
     };
 
-    write_fn(erase_line_right_suffix);
+    detail::write_static(write_fn, erase_line_right_suffix);
 }
 
 }  // namespace terminalpp
@@ -3,13 +3,44 @@
 
 namespace terminalpp {
 
+namespace {
+
+// ==========================================================================
+// SUPPORTS_ENCODING
+// ==========================================================================
+bool supports_encoding(behaviour const &beh, mouse::encoding encoding)
+{
+    switch (encoding)
+    {
+        case mouse::encoding::sgr:
+            return beh.supports_sgr_mouse_encoding;
+        case mouse::encoding::sgr_pixels:
+            return beh.supports_sgr_pixel_mouse_encoding;
+        case mouse::encoding::normal:
+        default:
+            return false;
+    }
+}
+
+// ==========================================================================
+// ENCODING_MODE
+// ==========================================================================
+bytes encoding_mode(mouse::encoding encoding)
+{
+    return encoding == mouse::encoding::sgr_pixels
+             ? bytes{ansi::dec_pm::sgr_pixel_mouse_encoding}
+             : bytes{ansi::dec_pm::sgr_mouse_encoding};
+}
+
+}  // namespace
+
 // ==========================================================================
 // ENABLE_MOUSE::OPERATOR()
 // ==========================================================================
 void enable_mouse::operator()(
     terminalpp::behaviour const &beh,
     terminalpp::terminal_state &state,
-    terminal::write_function const &write_fn) const
+    write_continuation write_fn) const
 {
     if (beh.supports_basic_mouse_tracking)
     {
@@ -29,6 +60,20 @@ void enable_mouse::operator()(
         write_fn(
             {std::cbegin(ansi::dec_pm::set), std::cend(ansi::dec_pm::set)});
     }
+    else
+    {
+        // Without mouse tracking, there are no events to encode.
+        return;
+    }
+
+    if (supports_encoding(beh, encoding_))
+    {
+        detail::dec_pm(beh, write_fn);
+        write_fn(encoding_mode(encoding_));
+        write_fn(
+            {std::cbegin(ansi::dec_pm::set), std::cend(ansi::dec_pm::set)});
+        state.mouse_encoding_ = encoding_;
+    }
 }
 
 // ==========================================================================
@@ -37,7 +82,7 @@ void enable_mouse::operator()(
 void disable_mouse::operator()(
     terminalpp::behaviour const &beh,
     terminalpp::terminal_state &state,
-    terminal::write_function const &write_fn) const
+    write_continuation write_fn) const
 {
     if (beh.supports_basic_mouse_tracking)
     {
@@ -57,6 +102,15 @@ void disable_mouse::operator()(
         write_fn(
             {std::cbegin(ansi::dec_pm::reset), std::cend(ansi::dec_pm::reset)});
     }
+
+    if (state.mouse_encoding_ != mouse::encoding::normal)
+    {
+        detail::dec_pm(beh, write_fn);
+        write_fn(encoding_mode(state.mouse_encoding_));
+        write_fn(
+            {std::cbegin(ansi::dec_pm::reset), std::cend(ansi::dec_pm::reset)});
+        state.mouse_encoding_ = mouse::encoding::normal;
+    }
 }
 
 }  // namespace terminalpp
@@ -0,0 +1,45 @@
+#include "terminalpp/ansi/dec_private_mode.hpp"
+#include "terminalpp/detail/element_difference.hpp"
+#include "terminalpp/terminal.hpp"
+
+namespace terminalpp {
+
+// ==========================================================================
+// ENABLE_BRACKETED_PASTE::OPERATOR()
+// ==========================================================================
+void enable_bracketed_paste::operator()(
+    terminalpp::behaviour const &beh,
+    terminalpp::terminal_state &state,
+    write_continuation write_fn) const
+{
+    if (beh.supports_bracketed_paste)
+    {
+        detail::dec_pm(beh, write_fn);
+        write_fn(
+            {std::cbegin(ansi::dec_pm::bracketed_paste),
+             std::cend(ansi::dec_pm::bracketed_paste)});
+        write_fn(
+            {std::cbegin(ansi::dec_pm::set), std::cend(ansi::dec_pm::set)});
+    }
+}
+
+// ==========================================================================
+// DISABLE_BRACKETED_PASTE::OPERATOR()
+// ==========================================================================
+void disable_bracketed_paste::operator()(
+    terminalpp::behaviour const &beh,
+    terminalpp::terminal_state &state,
+    write_continuation write_fn) const
+{
+    if (beh.supports_bracketed_paste)
+    {
+        detail::dec_pm(beh, write_fn);
+        write_fn(
+            {std::cbegin(ansi::dec_pm::bracketed_paste),
+             std::cend(ansi::dec_pm::bracketed_paste)});
+        write_fn(
+            {std::cbegin(ansi::dec_pm::reset), std::cend(ansi::dec_pm::reset)});
+    }
+}
+
+}  // namespace terminalpp
@@ -11,7 +11,7 @@ namespace terminalpp {
 void set_window_title::operator()(
     terminalpp::behaviour const &beh,
     terminalpp::terminal_state &state,
-    terminal::write_function const &write_fn) const
+    write_continuation write_fn) const
 {
     static byte_storage const set_window_title_prefix = {
         ansi::osc::set_window_title,
@@ -49,7 +49,7 @@ void set_window_title::operator()(
 void use_normal_screen_buffer::operator()(
     terminalpp::behaviour const &beh,
     terminalpp::terminal_state &state,
-    terminal::write_function const &write_fn) const
+    write_continuation write_fn) const
 {
     detail::dec_pm(beh, write_fn);
 
@@ -67,7 +67,7 @@ void use_normal_screen_buffer::operator()(
 void use_alternate_screen_buffer::operator()(
     terminalpp::behaviour const &beh,
     terminalpp::terminal_state &state,
-    terminal::write_function const &write_fn) const
+    write_continuation write_fn) const
 {
     detail::dec_pm(beh, write_fn);
 
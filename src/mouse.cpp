@@ -39,6 +39,27 @@ std::ostream &operator<<(std::ostream &out, event const &ev)
             break;
     }
 
+    switch (ev.button_)
+    {
+        case button::left:
+            out << ", left";
+            break;
+        case button::middle:
+            out << ", middle";
+            break;
+        case button::right:
+            out << ", right";
+            break;
+        case button::none:
+        default:
+            break;
+    }
+
+    if (ev.modifiers_ != vk_modifier::none)
+    {
+        out << ", " << ev.modifiers_;
+    }
+
     return out << "]";
 }
 
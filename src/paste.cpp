@@ -0,0 +1,18 @@
+#include "terminalpp/paste.hpp"
+
+#include <iostream>
+#include <iterator>
+
+namespace terminalpp {
+
+// ==========================================================================
+// OPERATOR<<
+// ==========================================================================
+std::ostream &operator<<(std::ostream &out, paste const &pst)
+{
+    out << R"(paste[")";
+    std::ranges::copy(pst.text, std::ostream_iterator<char>(out));
+    return out << R"("])";
+}
+
+}  // namespace terminalpp
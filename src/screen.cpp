@@ -1,38 +1,91 @@
 #include "terminalpp/screen.hpp"
 
-#include "terminalpp/algorithm/for_each_in_region.hpp"
+#include <algorithm>
+#include <span>
+#include <cstddef>
 
 namespace terminalpp {
 
+namespace {
+
+// The shortest cursor movement forward (CSI C) is three bytes long, so a gap
+// of up to this many unchanged elements can be rewritten more cheaply than
+// it can be skipped, provided that rewriting it requires no other sequences.
+constexpr std::size_t max_rewritten_gap = 2;
+
+}  // namespace
+
 // ==========================================================================
 // CONSTRUCTOR
 // ==========================================================================
-screen::screen(terminal &term) : terminal_(term)
+screen_base::screen_base()
+{
+    back_buffer_.set_dirty_tracking(true);
+}
+
+// ==========================================================================
+// BACK_BUFFER
+// ==========================================================================
+canvas &screen_base::back_buffer()
 {
+    return back_buffer_;
 }
 
 // ==========================================================================
-// DRAW
+// SET_FRAME_SKIPPING
 // ==========================================================================
-void screen::draw(canvas const &cvs)
+void screen_base::set_frame_skipping(bool enabled)
 {
-    if (cvs.size() != last_frame_.size())
+    frame_skipping_ = enabled;
+}
+
+// ==========================================================================
+// HAS_PENDING_FRAME
+// ==========================================================================
+bool screen_base::has_pending_frame() const
+{
+    return frame_pending_;
+}
+
+// ==========================================================================
+// BEGIN_FRAME
+// ==========================================================================
+bool screen_base::begin_frame(canvas const &cvs)
+{
+    frame_pending_ = false;
+
+    // The dirty regions of a canvas only describe its differences from the
+    // previous frame if it was also the previous canvas drawn, and the
+    // terminal has not been cleared since.
+    auto const size_changed = cvs.size() != last_frame_.size();
+
+    if (size_changed)
     {
         last_frame_ = canvas(cvs.size());
-        terminal_ << erase_display();
     }
 
-    for_each_in_region(
-        cvs,
-        {{}, cvs.size()},
-        [this](element const &elem, coordinate_type x, coordinate_type y) {
-            if (last_frame_[x][y] != elem)
-            {
-                terminal_ << move_cursor({x, y}) << elem;
-            }
-        });
-
-    last_frame_ = cvs;
+    if (&cvs != &back_buffer_)
+    {
+        back_buffer_.mark_dirty({{}, back_buffer_.size()});
+    }
+
+    return size_changed;
 }
 
+// ==========================================================================
+// IS_CHEAP_TO_REWRITE
+// ==========================================================================
+bool screen_base::is_cheap_to_rewrite(
+    element const &previous, std::span<element const> gap)
+{
+    return gap.size() <= max_rewritten_gap
+        && std::ranges::all_of(gap, [&previous](element const &elem) {
+               return elem.attribute_ == previous.attribute_
+                   && elem.glyph_.charset_ == previous.glyph_.charset_
+                   && elem.glyph_.charset_ != charset::utf8;
+           });
+}
+
+template class basic_screen<terminal>;
+
 }  // namespace terminalpp
@@ -0,0 +1,468 @@
+#include "terminalpp/socket_channel.hpp"
+
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <numeric>
+#include <system_error>
+#include <utility>
+#include <cerrno>
+
+namespace terminalpp {
+
+namespace {
+
+// The most fragments that are gathered into a single call to sendmsg.
+constexpr std::size_t max_gathered_fragments = 64;
+
+// ==========================================================================
+// THROW_LAST_ERROR
+// ==========================================================================
+[[noreturn]] void throw_last_error(char const *what)
+{
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+// ==========================================================================
+// CREATE_EPOLL
+// ==========================================================================
+int create_epoll()
+{
+    auto const fd = ::epoll_create1(EPOLL_CLOEXEC);
+
+    if (fd == -1)
+    {
+        throw_last_error("epoll_create1");
+    }
+
+    return fd;
+}
+
+// ==========================================================================
+// MAKE_NON_BLOCKING
+// ==========================================================================
+void make_non_blocking(int fd)
+{
+    auto const flags = ::fcntl(fd, F_GETFL);
+
+    if (flags == -1 || ::fcntl(fd, F_SETFL, flags | O_NONBLOCK) == -1)
+    {
+        throw_last_error("fcntl");
+    }
+}
+
+}  // namespace
+
+// ==========================================================================
+// CONSTRUCTOR
+// ==========================================================================
+epoll_loop::epoll_loop()
+  : epoll_fd_(create_epoll()), events_(max_events)
+{
+}
+
+// ==========================================================================
+// DESTRUCTOR
+// ==========================================================================
+epoll_loop::~epoll_loop()
+{
+    ::close(epoll_fd_);
+}
+
+// ==========================================================================
+// POLL
+// ==========================================================================
+std::size_t epoll_loop::poll(std::chrono::milliseconds timeout)
+{
+    auto const count = ::epoll_wait(
+        epoll_fd_,
+        events_.data(),
+        static_cast<int>(events_.size()),
+        static_cast<int>(timeout.count()));
+
+    if (count <= 0)
+    {
+        return 0;
+    }
+
+    received_ = static_cast<std::size_t>(count);
+    std::size_t serviced = 0;
+
+    // Servicing a channel may destroy another channel whose events are yet
+    // to be dispatched, in which case remove() will have cleared them.
+    for (std::size_t index = 0; index < received_; ++index)
+    {
+        auto const &event = events_[index];
+
+        if (auto *channel = static_cast<socket_channel *>(event.data.ptr);
+            channel != nullptr)
+        {
+            channel->handle_events(event.events);
+            ++serviced;
+        }
+    }
+
+    received_ = 0;
+    return serviced;
+}
+
+// ==========================================================================
+// ADD
+// ==========================================================================
+void epoll_loop::add(int fd, socket_channel *channel)
+{
+    // Errors and hang-ups are always reported, even with no other interest.
+    epoll_event event{.events = 0, .data = {.ptr = channel}};
+
+    if (::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) == -1)
+    {
+        throw_last_error("epoll_ctl");
+    }
+}
+
+// ==========================================================================
+// MODIFY
+// ==========================================================================
+void epoll_loop::modify(int fd, socket_channel *channel, std::uint32_t events)
+{
+    epoll_event event{.events = events, .data = {.ptr = channel}};
+    ::epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, fd, &event);
+}
+
+// ==========================================================================
+// REMOVE
+// ==========================================================================
+void epoll_loop::remove(int fd, socket_channel *channel)
+{
+    ::epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+
+    for (std::size_t index = 0; index < received_; ++index)
+    {
+        if (events_[index].data.ptr == channel)
+        {
+            events_[index].data.ptr = nullptr;
+        }
+    }
+}
+
+// ==========================================================================
+// CONSTRUCTOR
+// ==========================================================================
+socket_channel::socket_channel(
+    epoll_loop &loop, int fd, output_watermarks watermarks)
+  : loop_(loop), fd_(fd), watermarks_(watermarks)
+{
+    make_non_blocking(fd_);
+    loop_.add(fd_, this);
+}
+
+// ==========================================================================
+// DESTRUCTOR
+// ==========================================================================
+socket_channel::~socket_channel()
+{
+    // Neither an outstanding read nor the backpressure callback may be
+    // called back while the channel is being destroyed.
+    read_callback_ = nullptr;
+    backpressure_callback_ = nullptr;
+    die();
+}
+
+// ==========================================================================
+// ASYNC_READ
+// ==========================================================================
+void socket_channel::async_read(read_callback const &callback)
+{
+    if (is_alive())
+    {
+        read_callback_ = callback;
+        update_interest();
+    }
+    else
+    {
+        callback({});
+    }
+}
+
+// ==========================================================================
+// WRITE
+// ==========================================================================
+void socket_channel::write(terminalpp::bytes data)
+{
+    write(std::span{&data, 1});
+}
+
+// ==========================================================================
+// WRITE
+// ==========================================================================
+void socket_channel::write(std::span<terminalpp::bytes const> data)
+{
+    if (!is_alive())
+    {
+        return;
+    }
+
+    std::size_t sent = 0;
+
+    // Writing directly is only possible if nothing is queued ahead of this
+    // data, since otherwise it would be sent out of order.
+    if (queue_.empty())
+    {
+        std::array<iovec, max_gathered_fragments> fragments{};
+        msghdr message{};
+        message.msg_iov = fragments.data();
+        message.msg_iovlen = detail::gather(data, fragments);
+
+        auto const result = ::sendmsg(fd_, &message, MSG_NOSIGNAL);
+
+        if (result < 0 && !detail::would_block())
+        {
+            die();
+            return;
+        }
+
+        sent = result < 0 ? 0 : static_cast<std::size_t>(result);
+    }
+
+    auto const size = std::accumulate(
+        data.begin(),
+        data.end(),
+        std::size_t{0},
+        [](std::size_t total, bytes fragment) {
+            return total + fragment.size();
+        });
+
+    if (sent == size)
+    {
+        return;
+    }
+
+    if (queue_.size() + (size - sent) > watermarks_.capacity)
+    {
+        die();
+        return;
+    }
+
+    queue_.push(data, sent);
+    update_backpressure();
+    update_interest();
+}
+
+// ==========================================================================
+// IS_ALIVE
+// ==========================================================================
+bool socket_channel::is_alive() const
+{
+    return fd_ != -1;
+}
+
+// ==========================================================================
+// CLOSE
+// ==========================================================================
+void socket_channel::close()
+{
+    // If the queue cannot be written, then the channel has already died,
+    // and may have been destroyed by its read callback.
+    if (is_alive() && write_queue())
+    {
+        die();
+    }
+}
+
+// ==========================================================================
+// IS_BACKPRESSURED
+// ==========================================================================
+bool socket_channel::is_backpressured() const
+{
+    return backpressured_;
+}
+
+// ==========================================================================
+// ON_BACKPRESSURE
+// ==========================================================================
+void socket_channel::on_backpressure(backpressure_callback const &callback)
+{
+    backpressure_callback_ = callback;
+}
+
+// ==========================================================================
+// PENDING
+// ==========================================================================
+std::size_t socket_channel::pending() const
+{
+    return queue_.size();
+}
+
+// ==========================================================================
+// HANDLE_EVENTS
+// ==========================================================================
+void socket_channel::handle_events(std::uint32_t events)
+{
+    if ((events & EPOLLOUT) != 0)
+    {
+        // If the queue cannot be written, then the channel has died, and
+        // its read callback may have destroyed it.
+        if (!write_queue())
+        {
+            return;
+        }
+
+        update_backpressure();
+        update_interest();
+    }
+
+    if (!is_alive())
+    {
+        return;
+    }
+
+    // Reading is done last, since the read callback may destroy the
+    // channel.
+    if ((events & (EPOLLIN | EPOLLHUP | EPOLLERR)) != 0)
+    {
+        if (read_callback_)
+        {
+            read_input();
+        }
+        else if ((events & (EPOLLHUP | EPOLLERR)) != 0)
+        {
+            // Hang-ups and errors are reported for as long as they persist,
+            // even with no interest, so the channel must die here rather
+            // than wait for a read that would otherwise be busy-polled.
+            die();
+        }
+    }
+}
+
+// ==========================================================================
+// READ_INPUT
+// ==========================================================================
+void socket_channel::read_input()
+{
+    auto const count =
+        ::recv(fd_, read_buffer_.data(), read_buffer_.size(), 0);
+
+    if (count < 0 && detail::would_block())
+    {
+        return;
+    }
+
+    if (count <= 0)
+    {
+        die();
+        return;
+    }
+
+    // The callback will usually request another read, which replaces the
+    // stored callback, and so it is moved out before it is called.  Until
+    // then, the channel is not interested in any further input.
+    auto callback = std::exchange(read_callback_, nullptr);
+    update_interest();
+    callback(bytes{read_buffer_.data(), static_cast<std::size_t>(count)});
+}
+
+// ==========================================================================
+// WRITE_QUEUE
+// ==========================================================================
+bool socket_channel::write_queue()
+{
+    while (!queue_.empty())
+    {
+        std::array<iovec, max_gathered_fragments> fragments{};
+        msghdr message{};
+        message.msg_iov = fragments.data();
+        message.msg_iovlen = queue_.gather(fragments);
+
+        auto const sent = ::sendmsg(fd_, &message, MSG_NOSIGNAL);
+
+        if (sent < 0)
+        {
+            if (!detail::would_block())
+            {
+                die();
+                return false;
+            }
+
+            return true;
+        }
+
+        queue_.consume(static_cast<std::size_t>(sent));
+    }
+
+    return true;
+}
+
+// ==========================================================================
+// UPDATE_BACKPRESSURE
+// ==========================================================================
+void socket_channel::update_backpressure()
+{
+    auto const backpressured = backpressured_
+                                 ? queue_.size() > watermarks_.low
+                                 : queue_.size() >= watermarks_.high;
+
+    if (backpressured != backpressured_)
+    {
+        backpressured_ = backpressured;
+
+        if (backpressure_callback_)
+        {
+            backpressure_callback_(backpressured_);
+        }
+    }
+}
+
+// ==========================================================================
+// UPDATE_INTEREST
+// ==========================================================================
+void socket_channel::update_interest()
+{
+    if (!is_alive())
+    {
+        return;
+    }
+
+    std::uint32_t const interest = (read_callback_ ? EPOLLIN : 0U)
+                                 | (queue_.empty() ? 0U : EPOLLOUT);
+
+    if (interest != interest_)
+    {
+        interest_ = interest;
+        loop_.modify(fd_, this, interest_);
+    }
+}
+
+// ==========================================================================
+// DIE
+// ==========================================================================
+void socket_channel::die()
+{
+    if (!is_alive())
+    {
+        return;
+    }
+
+    loop_.remove(fd_, this);
+    ::close(fd_);
+    fd_ = -1;
+    queue_.clear();
+
+    // Either callback may destroy the channel, and so both are taken out
+    // of it before either is called.
+    auto const was_backpressured = std::exchange(backpressured_, false);
+    auto const on_backpressure = backpressure_callback_;
+    auto const on_read = std::exchange(read_callback_, nullptr);
+
+    if (was_backpressured && on_backpressure)
+    {
+        on_backpressure(false);
+    }
+
+    if (on_read)
+    {
+        on_read({});
+    }
+}
+
+}  // namespace terminalpp
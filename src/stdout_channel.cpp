@@ -1,14 +1,93 @@
 #include "terminalpp/stdout_channel.hpp"
 
-#include <iostream>
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <array>
+#include <utility>
+#include <cerrno>
 
 namespace terminalpp {
 
+namespace {
+
+// The most fragments that are gathered into a single call to writev.
+constexpr std::size_t max_gathered_fragments = 64;
+
+// ==========================================================================
+// MAKE_NON_BLOCKING
+// ==========================================================================
+int make_non_blocking(int fd)
+{
+    auto const flags = ::fcntl(fd, F_GETFL);
+
+    if (flags != -1)
+    {
+        ::fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+    }
+
+    return flags;
+}
+
+// ==========================================================================
+// RESTORE_FLAGS
+// ==========================================================================
+void restore_flags(int fd, int flags)
+{
+    if (flags != -1)
+    {
+        ::fcntl(fd, F_SETFL, flags);
+    }
+}
+
+}  // namespace
+
+// ==========================================================================
+// CONSTRUCTOR
+// ==========================================================================
+stdout_channel::stdout_channel() : stdout_channel(STDIN_FILENO, STDOUT_FILENO)
+{
+}
+
+// ==========================================================================
+// CONSTRUCTOR
+// ==========================================================================
+stdout_channel::stdout_channel(int input_fd, int output_fd)
+  : input_fd_(input_fd),
+    output_fd_(output_fd),
+    input_flags_(make_non_blocking(input_fd)),
+    output_flags_(make_non_blocking(output_fd))
+{
+}
+
+// ==========================================================================
+// DESTRUCTOR
+// ==========================================================================
+stdout_channel::~stdout_channel()
+{
+    flush();
+
+    // If both descriptors share a file description, then the input's flags
+    // were read after the output's were changed, so restore it first.
+    restore_flags(output_fd_, output_flags_);
+    restore_flags(input_fd_, input_flags_);
+}
+
 // ==========================================================================
 // ASYNC_READ
 // ==========================================================================
-void stdout_channel::async_read(std::function<void(terminalpp::bytes)> const &)
+void stdout_channel::async_read(read_callback const &callback)
 {
+    if (alive_)
+    {
+        read_callback_ = callback;
+    }
+    else
+    {
+        callback({});
+    }
 }
 
 // ==========================================================================
@@ -16,8 +95,45 @@ void stdout_channel::async_read(std::function<void(terminalpp::bytes)> const &)
 // ==========================================================================
 void stdout_channel::write(terminalpp::bytes data)
 {
-    // std::cout.write(reinterpret_cast<char const *>(data.begin()),
-    // data.ssize());
+    write(std::span{&data, 1});
+}
+
+// ==========================================================================
+// WRITE
+// ==========================================================================
+void stdout_channel::write(std::span<terminalpp::bytes const> data)
+{
+    if (!alive_)
+    {
+        return;
+    }
+
+    std::size_t sent = 0;
+
+    // Writing directly is only possible if nothing is queued ahead of this
+    // data, since otherwise it would be sent out of order.
+    if (queue_.empty())
+    {
+        std::array<iovec, max_gathered_fragments> fragments{};
+        auto const count = detail::gather(data, fragments);
+        auto const written =
+            ::writev(output_fd_, fragments.data(), static_cast<int>(count));
+
+        if (written < 0 && !detail::would_block())
+        {
+            die();
+            return;
+        }
+
+        sent = written < 0 ? 0 : static_cast<std::size_t>(written);
+    }
+
+    queue_.push(data, sent);
+
+    if (!queue_.empty())
+    {
+        write_queue();
+    }
 }
 
 // ==========================================================================
@@ -25,7 +141,7 @@ void stdout_channel::write(terminalpp::bytes data)
 // ==========================================================================
 bool stdout_channel::is_alive() const
 {
-    return true;
+    return alive_;
 }
 
 // ==========================================================================
@@ -33,6 +149,213 @@ bool stdout_channel::is_alive() const
 // ==========================================================================
 void stdout_channel::close()
 {
+    flush();
+    die();
+}
+
+// ==========================================================================
+// POLL
+// ==========================================================================
+bool stdout_channel::poll(std::chrono::milliseconds timeout)
+{
+    std::array<pollfd, 2> fds{};
+    nfds_t count = 0;
+    auto const reading = alive_ && static_cast<bool>(read_callback_);
+    auto const writing = alive_ && !queue_.empty();
+
+    if (reading)
+    {
+        fds[count++] = {.fd = input_fd_, .events = POLLIN, .revents = 0};
+    }
+
+    if (writing)
+    {
+        fds[count++] = {.fd = output_fd_, .events = POLLOUT, .revents = 0};
+    }
+
+    if (count == 0
+        || ::poll(fds.data(), count, static_cast<int>(timeout.count())) <= 0)
+    {
+        return false;
+    }
+
+    auto progressed = false;
+
+    if (reading && fds[0].revents != 0)
+    {
+        progressed = read_input();
+    }
+
+    if (writing && fds[count - 1].revents != 0)
+    {
+        progressed = write_queue() || progressed;
+    }
+
+    return progressed;
+}
+
+// ==========================================================================
+// FLUSH
+// ==========================================================================
+void stdout_channel::flush()
+{
+    while (alive_ && !queue_.empty())
+    {
+        pollfd fd{.fd = output_fd_, .events = POLLOUT, .revents = 0};
+
+        if (::poll(&fd, 1, -1) < 0 && errno != EINTR)
+        {
+            die();
+        }
+        else
+        {
+            write_queue();
+        }
+    }
+}
+
+// ==========================================================================
+// IS_BACKPRESSURED
+// ==========================================================================
+bool stdout_channel::is_backpressured() const
+{
+    return !queue_.empty();
+}
+
+// ==========================================================================
+// PENDING
+// ==========================================================================
+std::size_t stdout_channel::pending() const
+{
+    return queue_.size();
+}
+
+// ==========================================================================
+// READ_INPUT
+// ==========================================================================
+bool stdout_channel::read_input()
+{
+    std::array<byte, read_buffer_size> buffer;
+    auto const count = ::read(input_fd_, buffer.data(), buffer.size());
+
+    if (count < 0 && detail::would_block())
+    {
+        return false;
+    }
+
+    if (count <= 0)
+    {
+        die();
+        return true;
+    }
+
+    // The callback is moved out before it is called, since it will usually
+    // request another read, which replaces the stored callback.
+    auto callback = std::exchange(read_callback_, nullptr);
+    callback(bytes{buffer.data(), static_cast<std::size_t>(count)});
+    return true;
+}
+
+// ==========================================================================
+// WRITE_QUEUE
+// ==========================================================================
+bool stdout_channel::write_queue()
+{
+    auto progressed = false;
+
+    while (!queue_.empty())
+    {
+        std::array<iovec, max_gathered_fragments> fragments{};
+        auto const count = queue_.gather(fragments);
+        auto const written =
+            ::writev(output_fd_, fragments.data(), static_cast<int>(count));
+
+        if (written < 0)
+        {
+            if (!detail::would_block())
+            {
+                die();
+            }
+
+            break;
+        }
+
+        progressed = true;
+        queue_.consume(static_cast<std::size_t>(written));
+    }
+
+    return progressed;
+}
+
+// ==========================================================================
+// DIE
+// ==========================================================================
+void stdout_channel::die()
+{
+    alive_ = false;
+    queue_.clear();
+
+    if (auto callback = std::exchange(read_callback_, nullptr); callback)
+    {
+        callback({});
+    }
+}
+
+struct raw_mode::saved_mode
+{
+    termios attributes_;
+};
+
+// ==========================================================================
+// CONSTRUCTOR
+// ==========================================================================
+raw_mode::raw_mode() : raw_mode(STDIN_FILENO)
+{
+}
+
+// ==========================================================================
+// CONSTRUCTOR
+// ==========================================================================
+raw_mode::raw_mode(int fd) : fd_(fd)
+{
+    termios attributes{};
+
+    if (::isatty(fd_) == 0 || ::tcgetattr(fd_, &attributes) != 0)
+    {
+        return;
+    }
+
+    auto saved = std::make_unique<saved_mode>(attributes);
+
+    attributes.c_iflag &= ~tcflag_t{BRKINT | ICRNL | INPCK | ISTRIP | IXON};
+    attributes.c_cflag |= tcflag_t{CS8};
+    attributes.c_lflag &= ~tcflag_t{ECHO | ICANON | IEXTEN | ISIG};
+    attributes.c_cc[VMIN] = 1;
+    attributes.c_cc[VTIME] = 0;
+
+    if (::tcsetattr(fd_, TCSAFLUSH, &attributes) == 0)
+    {
+        saved_mode_ = std::move(saved);
+    }
+}
+
+// ==========================================================================
+// DESTRUCTOR
+// ==========================================================================
+raw_mode::~raw_mode()
+{
+    if (saved_mode_)
+    {
+        ::tcsetattr(fd_, TCSAFLUSH, &saved_mode_->attributes_);
+    }
+}
+
+// ==========================================================================
+// IS_ACTIVE
+// ==========================================================================
+bool raw_mode::is_active() const
+{
+    return static_cast<bool>(saved_mode_);
 }
 
 }  // namespace terminalpp
@@ -0,0 +1,163 @@
+#include "terminalpp/stdout_channel.hpp"
+
+#include <io.h>
+
+#include <algorithm>
+#include <utility>
+#include <climits>
+#include <cstdio>
+
+namespace terminalpp {
+
+// ==========================================================================
+// CONSTRUCTOR
+// ==========================================================================
+stdout_channel::stdout_channel()
+  : stdout_channel(_fileno(stdin), _fileno(stdout))
+{
+}
+
+// ==========================================================================
+// CONSTRUCTOR
+// ==========================================================================
+stdout_channel::stdout_channel(int /*input_fd*/, int output_fd)
+  : output_fd_(output_fd)
+{
+}
+
+// ==========================================================================
+// DESTRUCTOR
+// ==========================================================================
+stdout_channel::~stdout_channel() = default;
+
+// ==========================================================================
+// ASYNC_READ
+// ==========================================================================
+void stdout_channel::async_read(read_callback const &callback)
+{
+    if (alive_)
+    {
+        read_callback_ = callback;
+    }
+    else
+    {
+        callback({});
+    }
+}
+
+// ==========================================================================
+// WRITE
+// ==========================================================================
+void stdout_channel::write(terminalpp::bytes data)
+{
+    while (alive_ && !data.empty())
+    {
+        auto const count = static_cast<unsigned int>(
+            (std::min)(data.size(), std::size_t{INT_MAX}));
+        auto const written = ::_write(output_fd_, data.data(), count);
+
+        if (written <= 0)
+        {
+            alive_ = false;
+            return;
+        }
+
+        data = data.subspan(static_cast<std::size_t>(written));
+    }
+}
+
+// ==========================================================================
+// WRITE
+// ==========================================================================
+void stdout_channel::write(std::span<terminalpp::bytes const> data)
+{
+    for (auto const fragment : data)
+    {
+        write(fragment);
+    }
+}
+
+// ==========================================================================
+// IS_ALIVE
+// ==========================================================================
+bool stdout_channel::is_alive() const
+{
+    return alive_;
+}
+
+// ==========================================================================
+// CLOSE
+// ==========================================================================
+void stdout_channel::close()
+{
+    alive_ = false;
+
+    if (auto callback = std::exchange(read_callback_, nullptr); callback)
+    {
+        callback({});
+    }
+}
+
+// ==========================================================================
+// POLL
+// ==========================================================================
+bool stdout_channel::poll(std::chrono::milliseconds /*timeout*/)
+{
+    return false;
+}
+
+// ==========================================================================
+// FLUSH
+// ==========================================================================
+void stdout_channel::flush()
+{
+}
+
+// ==========================================================================
+// IS_BACKPRESSURED
+// ==========================================================================
+bool stdout_channel::is_backpressured() const
+{
+    return false;
+}
+
+// ==========================================================================
+// PENDING
+// ==========================================================================
+std::size_t stdout_channel::pending() const
+{
+    return 0;
+}
+
+struct raw_mode::saved_mode
+{
+};
+
+// ==========================================================================
+// CONSTRUCTOR
+// ==========================================================================
+raw_mode::raw_mode() : raw_mode(_fileno(stdin))
+{
+}
+
+// ==========================================================================
+// CONSTRUCTOR
+// ==========================================================================
+raw_mode::raw_mode(int fd) : fd_(fd)
+{
+}
+
+// ==========================================================================
+// DESTRUCTOR
+// ==========================================================================
+raw_mode::~raw_mode() = default;
+
+// ==========================================================================
+// IS_ACTIVE
+// ==========================================================================
+bool raw_mode::is_active() const
+{
+    return false;
+}
+
+}  // namespace terminalpp
@@ -1,65 +1,108 @@
 #include "terminalpp/terminal.hpp"
 
-#include "terminalpp/detail/well_known_virtual_key.hpp"
+#include "terminalpp/detail/token_coalescing.hpp"
 
 #include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <utility>
+#include <cstddef>
 
 namespace terminalpp {
 
+namespace {
+
 // ==========================================================================
-// DESTRUCTOR
+// BATCH_INSERTER
 // ==========================================================================
-terminal::~terminal() = default;
+// An output iterator that adds each token that it is given to a batch in
+// compact form, unless it can be coalesced into the last token of the
+// batch.  This allows the parser to fill a batch directly.
+class batch_inserter
+{
+public:
+    using difference_type = std::ptrdiff_t;
+
+    batch_inserter(token_batch &batch, bool mouse_motion, bool key_repeats)
+      : batch_(&batch), mouse_motion_(mouse_motion), key_repeats_(key_repeats)
+    {
+    }
+
+    batch_inserter &operator=(token &&tok)
+    {
+        if (!detail::merge_into_last(
+                *batch_, tok, mouse_motion_, key_repeats_))
+        {
+            batch_->push_back(std::move(tok));
+        }
+
+        return *this;
+    }
+
+    batch_inserter &operator*() noexcept
+    {
+        return *this;
+    }
+
+    batch_inserter &operator++() noexcept
+    {
+        return *this;
+    }
+
+    batch_inserter operator++(int) noexcept
+    {
+        return *this;
+    }
+
+private:
+    token_batch *batch_;
+    bool mouse_motion_;
+    bool key_repeats_;
+};
+
+}  // namespace
 
 // ==========================================================================
-// ASYNC_READ
+// CONSTRUCTOR
 // ==========================================================================
-void terminal::async_read(std::function<void(tokens)> const &callback)
+terminal_base::terminal_base(behaviour beh) : behaviour_(std::move(beh))
 {
-    channel_->async_read([this, callback](terminalpp::bytes data) {
-        std::vector<token> results;
-
-        for (const auto datum : data)
-        {
-            if (auto const result = state_.input_parser_(datum);
-                result.has_value())
-            {
-                results.push_back(detail::get_well_known_virtual_key(*result));
-            }
-        };
-
-        callback(results);
-    });
 }
 
 // ==========================================================================
-// WRITE
+// DESTRUCTOR
+// ==========================================================================
+terminal_base::~terminal_base() = default;
+
+// ==========================================================================
+// SET_ATTRIBUTE_TRANSITION_CACHE
 // ==========================================================================
-void terminal::write(bytes data)
+void terminal_base::set_attribute_transition_cache(
+    std::shared_ptr<attribute_transition_cache> cache)
 {
-    channel_->write(data);
+    state_.attribute_transition_cache_ = std::move(cache);
 }
 
 // ==========================================================================
-// IS_ALIVE
+// SET_MOUSE_MOTION_COALESCING
 // ==========================================================================
-bool terminal::is_alive() const
+void terminal_base::set_mouse_motion_coalescing(bool enabled)
 {
-    return channel_->is_alive();
+    coalesce_mouse_motion_ = enabled;
 }
 
 // ==========================================================================
-// CLOSE
+// SET_KEY_REPEAT_COALESCING
 // ==========================================================================
-void terminal::close()
+void terminal_base::set_key_repeat_coalescing(bool enabled)
 {
-    channel_->close();
+    coalesce_key_repeats_ = enabled;
 }
 
 // ==========================================================================
 // SET_SIZE
 // ==========================================================================
-void terminal::set_size(extent size)
+void terminal_base::set_size(extent size)
 {
     state_.terminal_size_ = size;
 
@@ -71,26 +114,128 @@ void terminal::set_size(extent size)
 }
 
 // ==========================================================================
-// OPERATOR<<(element)
+// TOKENIZE
 // ==========================================================================
-terminal &terminal::operator<<(terminalpp::element const &elem)
+void terminal_base::tokenize(bytes data, token_storage &results)
 {
-    *this << write_optional_default_attribute();
-    return *this << write_element(elem);
+    results.clear();
+
+    state_.input_parser_.parse(data, std::back_inserter(results));
+
+    if (coalesce_mouse_motion_)
+    {
+        detail::coalesce_mouse_motion(results);
+    }
+
+    if (coalesce_key_repeats_)
+    {
+        detail::coalesce_key_repeats(results);
+    }
 }
 
 // ==========================================================================
-// OPERATOR<<(string)
+// TOKENIZE
 // ==========================================================================
-terminal &terminal::operator<<(terminalpp::string const &text)
+void terminal_base::tokenize(bytes data, token_batch &batch)
 {
-    *this << write_optional_default_attribute();
+    batch.clear();
 
-    std::ranges::for_each(text, [this](terminalpp::element const &elem) {
-        *this << write_element(elem);
-    });
+    state_.input_parser_.parse(
+        data,
+        batch_inserter{batch, coalesce_mouse_motion_, coalesce_key_repeats_});
+}
 
-    return *this;
+// ==========================================================================
+// BUFFER_STATIC
+// ==========================================================================
+void terminal_base::buffer_static(bytes data)
+{
+    if (gather_static_output_ && data.size() >= min_static_fragment_size
+        && static_fragments_.size() < max_static_fragments)
+    {
+        static_fragments_.push_back({output_buffer_.size(), data});
+        static_output_size_ += data.size();
+    }
+    else
+    {
+        output_buffer_.append(data.begin(), data.end());
+    }
 }
 
+// ==========================================================================
+// CLEAR_OUTPUT
+// ==========================================================================
+void terminal_base::clear_output()
+{
+    output_buffer_.clear();
+    static_fragments_.clear();
+    static_output_size_ = 0;
+}
+
+// ==========================================================================
+// OUTPUT_SIZE
+// ==========================================================================
+std::size_t terminal_base::output_size(std::span<bytes const> fragments) const
+{
+    return std::accumulate(
+        fragments.begin(),
+        fragments.end(),
+        output_buffer_.size() + static_output_size_,
+        [](std::size_t total, bytes fragment) {
+            return total + fragment.size();
+        });
+}
+
+// ==========================================================================
+// BUFFER_FRAGMENTS
+// ==========================================================================
+void terminal_base::buffer_fragments(std::span<bytes const> fragments)
+{
+    for (auto const fragment : fragments)
+    {
+        output_buffer_.append(fragment.begin(), fragment.end());
+    }
+}
+
+// ==========================================================================
+// COLLECT_FRAGMENTS
+// ==========================================================================
+std::span<bytes const> terminal_base::collect_fragments(
+    std::span<bytes const> fragments)
+{
+    // Rather than copying the fragments into the output buffer just to send
+    // them, they are sent directly after it.  Likewise, the static fragments
+    // are sent between the parts of the buffer that surround them.
+    output_fragments_.clear();
+
+    auto const buffered = bytes{output_buffer_};
+    std::size_t offset = 0;
+
+    for (auto const &fragment : static_fragments_)
+    {
+        if (fragment.offset_ != offset)
+        {
+            output_fragments_.push_back(
+                buffered.subspan(offset, fragment.offset_ - offset));
+            offset = fragment.offset_;
+        }
+
+        output_fragments_.push_back(fragment.data_);
+    }
+
+    if (offset != buffered.size())
+    {
+        output_fragments_.push_back(buffered.subspan(offset));
+    }
+
+    std::ranges::copy_if(
+        fragments,
+        std::back_inserter(output_fragments_),
+        [](bytes fragment) { return !fragment.empty(); });
+
+    return output_fragments_;
+}
+
+template class basic_terminal<any_channel>;
+
 }  // namespace terminalpp
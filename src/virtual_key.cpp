@@ -32,40 +32,6 @@ std::ostream &operator<<(
     return out;
 }
 
-// ==========================================================================
-// OPERATOR<<(VK_MODIFIER)
-// ==========================================================================
-std::ostream &operator<<(std::ostream &out, vk_modifier const &vkm)
-{
-    bool pipe = false;
-
-    if ((vkm & vk_modifier::shift) == vk_modifier::shift)
-    {
-        output_pipe(out, pipe);
-        out << "shift";
-    }
-
-    if ((vkm & vk_modifier::ctrl) == vk_modifier::ctrl)
-    {
-        output_pipe(out, pipe);
-        out << "ctrl";
-    }
-
-    if ((vkm & vk_modifier::alt) == vk_modifier::alt)
-    {
-        output_pipe(out, pipe);
-        out << "alt";
-    }
-
-    if ((vkm & vk_modifier::meta) == vk_modifier::meta)
-    {
-        output_pipe(out, pipe);
-        out << "meta";
-    }
-
-    return out;
-}
-
 // ==========================================================================
 // OUTPUT_COMMA
 // ==========================================================================
@@ -128,6 +94,40 @@ void output_input_sequence(
 
 }  // namespace
 
+// ==========================================================================
+// OPERATOR<<(VK_MODIFIER)
+// ==========================================================================
+std::ostream &operator<<(std::ostream &out, vk_modifier const &vkm)
+{
+    bool pipe = false;
+
+    if ((vkm & vk_modifier::shift) == vk_modifier::shift)
+    {
+        output_pipe(out, pipe);
+        out << "shift";
+    }
+
+    if ((vkm & vk_modifier::ctrl) == vk_modifier::ctrl)
+    {
+        output_pipe(out, pipe);
+        out << "ctrl";
+    }
+
+    if ((vkm & vk_modifier::alt) == vk_modifier::alt)
+    {
+        output_pipe(out, pipe);
+        out << "alt";
+    }
+
+    if ((vkm & vk_modifier::meta) == vk_modifier::meta)
+    {
+        output_pipe(out, pipe);
+        out << "meta";
+    }
+
+    return out;
+}
+
 // ==========================================================================
 // OPERATOR<<
 // ==========================================================================
@@ -0,0 +1,159 @@
+#include "terminalpp/attribute_transition_cache.hpp"
+
+#include "terminal_test.hpp"
+
+#include <gmock/gmock.h>
+
+#include <memory>
+#include <tuple>
+
+using namespace terminalpp::literals;  // NOLINT
+using testing::ContainerEq;
+
+namespace {
+
+constexpr terminalpp::attribute red_attribute = {
+    .foreground_colour_ = terminalpp::graphics::colour::red};
+
+constexpr terminalpp::attribute blue_attribute = {
+    .foreground_colour_ = terminalpp::graphics::colour::blue,
+    .intensity_ = terminalpp::graphics::intensity::bold};
+
+TEST(an_attribute_transition_cache, encodes_a_transition_on_first_use)
+{
+    terminalpp::attribute_transition_cache cache;
+
+    auto const result =
+        cache.get(red_attribute, blue_attribute, [](auto &encoding) {
+            encoding = "encoded"_tb;
+        });
+
+    EXPECT_THAT(
+        terminalpp::byte_storage(result.begin(), result.end()),
+        ContainerEq("encoded"_tb));
+    EXPECT_EQ(0U, cache.hits());
+    EXPECT_EQ(1U, cache.misses());
+}
+
+TEST(an_attribute_transition_cache, reuses_a_cached_transition)
+{
+    terminalpp::attribute_transition_cache cache;
+
+    auto const encode = [](auto &encoding) { encoding = "encoded"_tb; };
+    std::ignore = cache.get(red_attribute, blue_attribute, encode);
+
+    auto const result =
+        cache.get(red_attribute, blue_attribute, [](auto &encoding) {
+            encoding = "re-encoded"_tb;
+        });
+
+    EXPECT_THAT(
+        terminalpp::byte_storage(result.begin(), result.end()),
+        ContainerEq("encoded"_tb));
+    EXPECT_EQ(1U, cache.hits());
+    EXPECT_EQ(1U, cache.misses());
+}
+
+TEST(an_attribute_transition_cache, distinguishes_the_direction_of_transitions)
+{
+    terminalpp::attribute_transition_cache cache;
+
+    std::ignore = cache.get(red_attribute, blue_attribute, [](auto &encoding) {
+        encoding = "to blue"_tb;
+    });
+
+    auto const result =
+        cache.get(blue_attribute, red_attribute, [](auto &encoding) {
+            encoding = "to red"_tb;
+        });
+
+    EXPECT_THAT(
+        terminalpp::byte_storage(result.begin(), result.end()),
+        ContainerEq("to red"_tb));
+    EXPECT_EQ(2U, cache.misses());
+}
+
+TEST(an_attribute_transition_cache, is_bounded_by_its_capacity)
+{
+    terminalpp::attribute_transition_cache cache{1};
+    EXPECT_EQ(1U, cache.capacity());
+
+    auto const encode = [](auto &encoding) { encoding = "encoded"_tb; };
+    std::ignore = cache.get(red_attribute, blue_attribute, encode);
+    std::ignore = cache.get(blue_attribute, red_attribute, encode);
+    std::ignore = cache.get(red_attribute, blue_attribute, encode);
+
+    EXPECT_EQ(0U, cache.hits());
+    EXPECT_EQ(3U, cache.misses());
+}
+
+TEST(an_attribute_transition_cache, can_be_cleared)
+{
+    terminalpp::attribute_transition_cache cache;
+
+    auto const encode = [](auto &encoding) { encoding = "encoded"_tb; };
+    std::ignore = cache.get(red_attribute, blue_attribute, encode);
+    std::ignore = cache.get(red_attribute, blue_attribute, encode);
+
+    cache.clear();
+    EXPECT_EQ(0U, cache.hits());
+    EXPECT_EQ(0U, cache.misses());
+
+    std::ignore = cache.get(red_attribute, blue_attribute, encode);
+    EXPECT_EQ(0U, cache.hits());
+    EXPECT_EQ(1U, cache.misses());
+}
+
+class a_terminal_with_an_attribute_transition_cache : public a_terminal
+{
+public:
+    a_terminal_with_an_attribute_transition_cache()
+    {
+        terminal_.set_attribute_transition_cache(cache_);
+        reference_terminal_ << ""_ets;
+        reference_channel_.written_.clear();
+    }
+
+protected:
+    std::shared_ptr<terminalpp::attribute_transition_cache> cache_ =
+        std::make_shared<terminalpp::attribute_transition_cache>();
+    fake_channel reference_channel_;
+    terminalpp::terminal reference_terminal_{reference_channel_};
+};
+
+TEST_F(
+    a_terminal_with_an_attribute_transition_cache,
+    writes_the_same_output_as_a_terminal_without_one)
+{
+    terminalpp::string const text = {
+        {'a', red_attribute },
+        {'b', blue_attribute},
+        {'c', red_attribute },
+        {'d', blue_attribute},
+        {'e', red_attribute },
+        {'f', {}            },
+    };
+
+    terminal_ << text;
+    reference_terminal_ << text;
+
+    EXPECT_THAT(channel_.written_, ContainerEq(reference_channel_.written_));
+    EXPECT_EQ(2U, cache_->hits());
+    EXPECT_EQ(4U, cache_->misses());
+}
+
+TEST_F(
+    a_terminal_with_an_attribute_transition_cache,
+    does_not_consult_the_cache_when_the_attribute_is_unchanged)
+{
+    terminal_ << terminalpp::string{
+        {'a', red_attribute},
+        {'b', red_attribute},
+        {'c', red_attribute},
+    };
+
+    EXPECT_EQ(0U, cache_->hits());
+    EXPECT_EQ(1U, cache_->misses());
+}
+
+}  // namespace
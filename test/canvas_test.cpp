@@ -2,6 +2,9 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <tuple>
+
 namespace {
 
 TEST(canvas_test, can_perform_loops_over_a_canvas)
@@ -125,4 +128,192 @@ TEST(canvas_test, resizing_canvas_smaller_truncates_content)
     }
 }
 
+TEST(canvas_test, without_dirty_tracking_considers_every_row_dirty)
+{
+    terminalpp::canvas canvas({5, 5});
+    canvas.mark_clean();
+
+    auto const [first, last] = canvas.dirty_columns(2);
+    EXPECT_EQ(0, first);
+    EXPECT_EQ(5, last);
+}
+
+TEST(canvas_test, with_dirty_tracking_is_initially_dirty)
+{
+    terminalpp::canvas canvas({5, 5});
+    canvas.set_dirty_tracking(true);
+
+    auto const [first, last] = canvas.dirty_columns(2);
+    EXPECT_EQ(0, first);
+    EXPECT_EQ(5, last);
+}
+
+TEST(canvas_test, writing_to_an_element_marks_it_dirty)
+{
+    terminalpp::canvas canvas({5, 5});
+    canvas.set_dirty_tracking(true);
+    canvas.mark_clean();
+
+    canvas[1][2] = 'x';
+    canvas[3][2] = 'y';
+
+    auto const [first, last] = canvas.dirty_columns(2);
+    EXPECT_EQ(1, first);
+    EXPECT_EQ(4, last);
+
+    auto const [clean_first, clean_last] = canvas.dirty_columns(1);
+    EXPECT_EQ(clean_first, clean_last);
+}
+
+TEST(canvas_test, reading_from_a_const_canvas_does_not_mark_it_dirty)
+{
+    terminalpp::canvas canvas({5, 5});
+    canvas.set_dirty_tracking(true);
+    canvas.mark_clean();
+
+    terminalpp::canvas const &ccanvas = canvas;
+    std::ignore = terminalpp::element(ccanvas[1][2]);
+
+    auto const [first, last] = canvas.dirty_columns(2);
+    EXPECT_EQ(first, last);
+}
+
+TEST(canvas_test, marking_a_region_dirty_is_clipped_to_the_canvas)
+{
+    terminalpp::canvas canvas({5, 5});
+    canvas.set_dirty_tracking(true);
+    canvas.mark_clean();
+
+    canvas.mark_dirty({
+        {3,  -1},
+        {10, 3 }
+    });
+
+    for (terminalpp::coordinate_type row = 0; row < 2; ++row)
+    {
+        auto const [first, last] = canvas.dirty_columns(row);
+        EXPECT_EQ(3, first);
+        EXPECT_EQ(5, last);
+    }
+
+    auto const [first, last] = canvas.dirty_columns(2);
+    EXPECT_EQ(first, last);
+}
+
+TEST(canvas_test, resizing_a_tracked_canvas_marks_it_dirty)
+{
+    terminalpp::canvas canvas({5, 5});
+    canvas.set_dirty_tracking(true);
+    canvas.mark_clean();
+
+    canvas.resize({6, 6});
+
+    auto const [first, last] = canvas.dirty_columns(5);
+    EXPECT_EQ(0, first);
+    EXPECT_EQ(6, last);
+}
+
+TEST(canvas_test, rows_are_contiguous_spans_of_elements)
+{
+    terminalpp::canvas canvas({5, 5});
+    canvas[0][2] = 'a';
+    canvas[4][2] = 'e';
+
+    auto const row = canvas.row(2);
+    ASSERT_EQ(5U, row.size());
+    EXPECT_EQ(terminalpp::element{'a'}, row[0]);
+    EXPECT_EQ(terminalpp::element{'e'}, row[4]);
+
+    row[2] = 'c';
+    EXPECT_EQ(terminalpp::element{'c'}, terminalpp::element(canvas[2][2]));
+}
+
+TEST(canvas_test, accessing_a_row_marks_it_dirty)
+{
+    terminalpp::canvas canvas({5, 5});
+    canvas.set_dirty_tracking(true);
+    canvas.mark_clean();
+
+    std::ignore = canvas.row(3);
+
+    auto const [first, last] = canvas.dirty_columns(3);
+    EXPECT_EQ(0, first);
+    EXPECT_EQ(5, last);
+}
+
+TEST(canvas_test, can_fill_a_row)
+{
+    terminalpp::canvas canvas({5, 5});
+    canvas.fill_row(1, 'x');
+
+    terminalpp::canvas const &ccanvas = canvas;
+    EXPECT_TRUE(std::ranges::all_of(
+        ccanvas.row(1), [](auto const &elem) { return elem == 'x'; }));
+    EXPECT_TRUE(std::ranges::none_of(
+        ccanvas.row(2), [](auto const &elem) { return elem == 'x'; }));
+}
+
+TEST(canvas_test, can_copy_a_row)
+{
+    terminalpp::canvas canvas({5, 5});
+    canvas.blit({0, 1}, "abcde");
+
+    canvas.copy_row(1, 3);
+
+    terminalpp::canvas const &ccanvas = canvas;
+    EXPECT_TRUE(std::ranges::equal(ccanvas.row(1), ccanvas.row(3)));
+}
+
+TEST(canvas_test, blitting_a_string_copies_it_into_a_row)
+{
+    terminalpp::canvas canvas({5, 5});
+    canvas.set_dirty_tracking(true);
+    canvas.mark_clean();
+
+    canvas.blit({1, 2}, "abc");
+
+    terminalpp::canvas const &ccanvas = canvas;
+    terminalpp::string const expected = " abc ";
+    EXPECT_TRUE(std::ranges::equal(expected, ccanvas.row(2)));
+
+    auto const [first, last] = canvas.dirty_columns(2);
+    EXPECT_EQ(1, first);
+    EXPECT_EQ(4, last);
+}
+
+TEST(canvas_test, blitting_a_string_clips_it_to_the_canvas)
+{
+    terminalpp::canvas canvas({5, 5});
+
+    canvas.blit({-2, 0}, "abcd");
+    canvas.blit({3, 1}, "wxyz");
+
+    terminalpp::canvas const &ccanvas = canvas;
+    terminalpp::string const expected_first = "cd   ";
+    terminalpp::string const expected_second = "   wx";
+    EXPECT_TRUE(std::ranges::equal(expected_first, ccanvas.row(0)));
+    EXPECT_TRUE(std::ranges::equal(expected_second, ccanvas.row(1)));
+}
+
+TEST(canvas_test, blitting_a_string_outside_of_the_rows_does_nothing)
+{
+    terminalpp::canvas canvas({5, 5});
+    canvas.set_dirty_tracking(true);
+    canvas.mark_clean();
+
+    canvas.blit({0, -1}, "abcde");
+    canvas.blit({0, 5}, "abcde");
+
+    terminalpp::canvas const &ccanvas = canvas;
+
+    for (terminalpp::coordinate_type row = 0; row < 5; ++row)
+    {
+        EXPECT_TRUE(std::ranges::all_of(
+            ccanvas.row(row), [](auto const &elem) { return elem == ' '; }));
+
+        auto const [first, last] = canvas.dirty_columns(row);
+        EXPECT_EQ(first, last);
+    }
+}
+
 }  // namespace
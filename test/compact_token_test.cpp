@@ -0,0 +1,185 @@
+#include "fakes/fake_channel.hpp"
+#include "terminalpp/compact_token.hpp"
+#include "terminalpp/terminal.hpp"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using namespace terminalpp::literals;  // NOLINT
+using testing::ValuesIn;
+
+namespace {
+
+TEST(a_compact_token, is_much_smaller_than_a_token)
+{
+    EXPECT_LE(sizeof(terminalpp::compact_token), 32U);
+    EXPECT_LT(
+        2 * sizeof(terminalpp::compact_token), sizeof(terminalpp::token));
+}
+
+TEST(a_default_constructed_token_batch, is_empty)
+{
+    terminalpp::token_batch const batch;
+
+    EXPECT_TRUE(batch.empty());
+    EXPECT_EQ(0U, batch.size());
+    EXPECT_TRUE(batch.tokens().empty());
+}
+
+auto const pasted_text = "pasted"_tb;
+
+terminalpp::token const tokens_to_compact[] = {
+    terminalpp::virtual_key{
+                            .key = terminalpp::vk::lowercase_x,
+                            .repeat_count = 1,
+                            .sequence = 'x'_tb},
+    terminalpp::virtual_key{
+                            .key = terminalpp::vk::cursor_up,
+                            .modifiers = terminalpp::vk_modifier::shift,
+                            .repeat_count = 2,
+                            .sequence =
+            terminalpp::control_sequence{
+                .initiator = '[',
+                .command = 'A',
+                .arguments = {"2"_tb, "2"_tb}}},
+    terminalpp::mouse::event{
+        .action_ = terminalpp::mouse::event_type::left_button_down,
+        .position_ = {3, 4}},
+    terminalpp::control_sequence{
+                            .initiator = '[',
+                            .command = 'n',
+                            .extender = '?',
+                            .arguments = {"6"_tb}},
+    terminalpp::paste{pasted_text},
+};
+
+class tokens_to_compact_in_a_batch
+  : public testing::TestWithParam<terminalpp::token>
+{
+};
+
+TEST_P(tokens_to_compact_in_a_batch, expand_to_the_original_token)
+{
+    auto const &tok = GetParam();
+
+    terminalpp::token_batch batch;
+    batch.push_back(terminalpp::token{tok});
+
+    ASSERT_EQ(1U, batch.size());
+    EXPECT_EQ(tok, batch.expand(batch.tokens()[0]));
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    tokens_can_be_compacted,
+    tokens_to_compact_in_a_batch,
+    ValuesIn(tokens_to_compact));
+
+TEST(a_token_batch, stores_control_sequences_out_of_line)
+{
+    terminalpp::token_batch batch;
+
+    for (auto const &tok : tokens_to_compact)
+    {
+        batch.push_back(terminalpp::token{tok});
+    }
+
+    ASSERT_EQ(std::size(tokens_to_compact), batch.size());
+
+    auto const &key =
+        std::get<terminalpp::compact_virtual_key>(batch.tokens()[1]);
+    EXPECT_EQ(0U, key.sequence);
+    EXPECT_EQ('A', batch.sequence(key.sequence).command);
+
+    auto const &seq =
+        std::get<terminalpp::compact_control_sequence>(batch.tokens()[3]);
+    EXPECT_EQ(1U, seq.index);
+    EXPECT_EQ('n', batch.sequence(seq.index).command);
+}
+
+TEST(a_token_batch, allows_its_last_token_to_be_modified)
+{
+    terminalpp::token_batch batch;
+    batch.push_back(terminalpp::token{tokens_to_compact[0]});
+    batch.push_back(terminalpp::token{tokens_to_compact[1]});
+
+    std::get<terminalpp::compact_virtual_key>(batch.back()).repeat_count = 5;
+
+    auto const expanded = batch.expand(batch.tokens()[1]);
+    EXPECT_EQ(5, std::get<terminalpp::virtual_key>(expanded).repeat_count);
+}
+
+TEST(a_token_batch, can_be_cleared)
+{
+    terminalpp::token_batch batch;
+    batch.push_back(terminalpp::token{tokens_to_compact[1]});
+    batch.clear();
+
+    EXPECT_TRUE(batch.empty());
+
+    batch.push_back(terminalpp::token{tokens_to_compact[3]});
+    auto const &seq =
+        std::get<terminalpp::compact_control_sequence>(batch.tokens()[0]);
+    EXPECT_EQ(0U, seq.index);
+}
+
+TEST(a_terminal_reading_compact_tokens, delivers_the_same_tokens_as_async_read)
+{
+    auto const input = "ab\x1B[2A\x1B[?6n\x1B[M @B\x1B[200~text\x1B[201~"_tb;
+
+    fake_channel channel;
+    terminalpp::terminal terminal{channel};
+
+    std::vector<terminalpp::token> expected;
+    terminal.async_read([&expected](terminalpp::tokens tokens) {
+        expected.assign(tokens.begin(), tokens.end());
+    });
+    channel.receive(input);
+
+    std::vector<terminalpp::token> result;
+    terminal.async_read_compact(
+        [&result](terminalpp::token_batch const &batch) {
+            for (auto const &tok : batch.tokens())
+            {
+                result.push_back(batch.expand(tok));
+            }
+        });
+    channel.receive(input);
+
+    ASSERT_EQ(6U, expected.size());
+    ASSERT_EQ(expected, result);
+}
+
+TEST(
+    a_terminal_reading_compact_tokens,
+    coalesces_the_same_tokens_as_async_read)
+{
+    auto const input =
+        "xx\x1B[<35;1;1M\x1B[<35;2;1M\x1B[A\x1B[A\x1B[2Ay\x1B[<35;3;1M"_tb;
+
+    fake_channel channel;
+    terminalpp::terminal terminal{channel};
+    terminal.set_mouse_motion_coalescing(true);
+    terminal.set_key_repeat_coalescing(true);
+
+    std::vector<terminalpp::token> expected;
+    terminal.async_read([&expected](terminalpp::tokens tokens) {
+        expected.assign(tokens.begin(), tokens.end());
+    });
+    channel.receive(input);
+
+    std::vector<terminalpp::token> result;
+    terminal.async_read_compact(
+        [&result](terminalpp::token_batch const &batch) {
+            for (auto const &tok : batch.tokens())
+            {
+                result.push_back(batch.expand(tok));
+            }
+        });
+    channel.receive(input);
+
+    ASSERT_EQ(6U, expected.size());
+    ASSERT_EQ(expected, result);
+}
+
+}  // namespace
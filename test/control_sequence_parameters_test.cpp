@@ -0,0 +1,135 @@
+#include "terminalpp/detail/control_sequence_parameters.hpp"
+
+#include <gmock/gmock.h>
+
+#include <string_view>
+#include <vector>
+
+using testing::ElementsAre;
+using value_type = terminalpp::detail::control_sequence_parameters::value_type;
+
+namespace {
+
+// Feeds the parameter text of a sequence (e.g. "1;2:3") to the parameters,
+// as the parser would.
+terminalpp::detail::control_sequence_parameters make_parameters(
+    std::string_view text)
+{
+    terminalpp::detail::control_sequence_parameters parameters;
+
+    for (auto const ch : text)
+    {
+        if (ch == ';')
+        {
+            parameters.end_parameter();
+        }
+        else if (ch == ':')
+        {
+            parameters.end_sub_parameter();
+        }
+        else
+        {
+            parameters.append_digit(static_cast<terminalpp::byte>(ch));
+        }
+    }
+
+    parameters.end_parameter();
+    return parameters;
+}
+
+std::vector<value_type> sub_parameters_of(
+    terminalpp::detail::control_sequence_parameters const &parameters,
+    std::size_t index)
+{
+    auto const subs = parameters.sub_parameters(index);
+    return {subs.begin(), subs.end()};
+}
+
+TEST(default_constructed_control_sequence_parameters, are_empty)
+{
+    terminalpp::detail::control_sequence_parameters const parameters;
+
+    EXPECT_TRUE(parameters.empty());
+    EXPECT_EQ(0U, parameters.size());
+    EXPECT_FALSE(parameters.get(0).has_value());
+    EXPECT_EQ(7U, parameters.get_or(0, 7));
+}
+
+TEST(control_sequence_parameters, accumulate_decimal_values)
+{
+    auto const parameters = make_parameters("1;23;456");
+
+    ASSERT_EQ(3U, parameters.size());
+    EXPECT_EQ(1U, parameters.get(0));
+    EXPECT_EQ(23U, parameters.get(1));
+    EXPECT_EQ(456U, parameters.get(2));
+}
+
+TEST(control_sequence_parameters, record_omitted_values)
+{
+    auto const parameters = make_parameters(";5;");
+
+    ASSERT_EQ(3U, parameters.size());
+    EXPECT_FALSE(parameters.get(0).has_value());
+    EXPECT_EQ(5U, parameters.get(1));
+    EXPECT_FALSE(parameters.get(2).has_value());
+    EXPECT_EQ(1U, parameters.get_or(0, 1));
+}
+
+TEST(control_sequence_parameters, treat_an_empty_sequence_as_one_omitted_value)
+{
+    auto const parameters = make_parameters("");
+
+    ASSERT_EQ(1U, parameters.size());
+    EXPECT_FALSE(parameters.get(0).has_value());
+}
+
+TEST(control_sequence_parameters, hold_sub_parameters)
+{
+    auto const omitted = terminalpp::detail::control_sequence_parameters::omitted;
+    auto const parameters = make_parameters("4:3;38:2::255:128:0;1");
+
+    ASSERT_EQ(3U, parameters.size());
+    EXPECT_EQ(4U, parameters.get(0));
+    EXPECT_THAT(sub_parameters_of(parameters, 0), ElementsAre(3U));
+    EXPECT_EQ(38U, parameters.get(1));
+    EXPECT_THAT(
+        sub_parameters_of(parameters, 1),
+        ElementsAre(2U, omitted, 255U, 128U, 0U));
+    EXPECT_EQ(1U, parameters.get(2));
+    EXPECT_TRUE(parameters.sub_parameters(2).empty());
+    EXPECT_TRUE(parameters.sub_parameters(3).empty());
+}
+
+TEST(control_sequence_parameters, saturate_values_that_are_too_large)
+{
+    auto const parameters = make_parameters("99999999999999999999;1");
+
+    EXPECT_EQ(
+        terminalpp::detail::control_sequence_parameters::max_value,
+        parameters.get(0));
+    EXPECT_EQ(1U, parameters.get(1));
+}
+
+TEST(control_sequence_parameters, discard_values_beyond_their_capacity)
+{
+    auto const parameters = make_parameters(
+        "0;1;2;3;4;5;6;7;8;9;10;11;12;13;14:1;15;16;17");
+
+    ASSERT_EQ(
+        terminalpp::detail::control_sequence_parameters::capacity - 1,
+        parameters.size());
+    EXPECT_EQ(14U, parameters.get(14));
+    EXPECT_THAT(sub_parameters_of(parameters, 14), ElementsAre(1U));
+    EXPECT_FALSE(parameters.get(15).has_value());
+}
+
+TEST(control_sequence_parameters, compare_equal_when_their_values_are_equal)
+{
+    EXPECT_EQ(make_parameters("1;2:3"), make_parameters("1;2:3"));
+    EXPECT_EQ(make_parameters("01;2"), make_parameters("1;2"));
+    EXPECT_NE(make_parameters("1;2:3"), make_parameters("1;2;3"));
+    EXPECT_NE(make_parameters("1;"), make_parameters("1"));
+}
+
+}  // namespace
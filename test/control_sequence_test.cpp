@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 #include <terminalpp/control_sequence.hpp>
 
+#include <algorithm>
+#include <iterator>
 #include <tuple>
 
 using testing::ValuesIn;
@@ -19,6 +21,56 @@ TEST(a_default_constructed_control_sequence, has_a_known_value)
     ASSERT_EQ('\0', seq.extender);
 }
 
+TEST(control_sequence_arguments, are_split_from_their_text_when_used)
+{
+    auto const arguments =
+        terminalpp::control_sequence_arguments::from_text("1;;5"_tb);
+
+    EXPECT_EQ("1;;5"_tb, terminalpp::byte_storage(
+                             arguments.text().begin(), arguments.text().end()));
+    ASSERT_EQ(3U, arguments.size());
+    EXPECT_TRUE(std::ranges::equal("1"_tb, arguments[0]));
+    EXPECT_TRUE(arguments[1].empty());
+    EXPECT_TRUE(std::ranges::equal("5"_tb, arguments[2]));
+    EXPECT_EQ(3, std::ranges::distance(arguments));
+}
+
+TEST(control_sequence_arguments, are_joined_from_their_values)
+{
+    terminalpp::control_sequence_arguments const arguments = {
+        "24"_tb, "5"_tb};
+
+    EXPECT_EQ(
+        terminalpp::control_sequence_arguments::from_text("24;5"_tb),
+        arguments);
+    EXPECT_EQ(2U, arguments.size());
+}
+
+TEST(control_sequence_arguments, may_hold_text_that_does_not_fit_inline)
+{
+    auto const text = "62;1;2;6;7;8;9"_tb;
+    ASSERT_GT(
+        text.size(), terminalpp::control_sequence_arguments::inline_capacity);
+
+    auto const arguments =
+        terminalpp::control_sequence_arguments::from_text(text);
+    terminalpp::control_sequence_arguments const joined = {
+        "62"_tb, "1"_tb, "2"_tb, "6"_tb, "7"_tb, "8"_tb, "9"_tb};
+
+    EXPECT_TRUE(std::ranges::equal(text, arguments.text()));
+    EXPECT_EQ(7U, arguments.size());
+    EXPECT_EQ(arguments, joined);
+}
+
+TEST(control_sequence_arguments, with_no_text_are_empty)
+{
+    terminalpp::control_sequence_arguments const arguments;
+
+    EXPECT_TRUE(arguments.empty());
+    EXPECT_EQ(0U, arguments.size());
+    EXPECT_EQ(arguments.begin(), arguments.end());
+}
+
 using control_sequence_test_data = std::tuple<
     terminalpp::control_sequence,  // input data
     std::string                    // expected output
@@ -97,15 +149,15 @@ control_sequence_test_data const control_sequence_strings[] = {
          .initiator = default_sequence.initiator,
          .command = default_sequence.command,
          .meta = default_sequence.meta,
-         .arguments = default_sequence.arguments,
-         .extender = '*'},
+         .extender = '*',
+         .arguments = default_sequence.arguments},
      "control_sequence[extender:'*']"                                                       },
     {terminalpp::control_sequence{
          .initiator = default_sequence.initiator,
          .command = default_sequence.command,
          .meta = default_sequence.meta,
-         .arguments = default_sequence.arguments,
-         .extender = '?'},
+         .extender = '?',
+         .arguments = default_sequence.arguments},
      "control_sequence[extender:'?']"                                                       },
 
     // Control sequences with multiple active fields separate them with commas
@@ -113,16 +165,16 @@ control_sequence_test_data const control_sequence_strings[] = {
          .initiator = '[',
          .command = 'H',
          .meta = true,
-         .arguments = {"29"_tb},
-         .extender = '?'},
+         .extender = '?',
+         .arguments = {"29"_tb}},
      R"(control_sequence[initiator:'[', command:'H', meta, args:"29", extender:'?'])"       },
 
     {terminalpp::control_sequence{
          .initiator = '[',
          .command = 'H',
          .meta = default_sequence.meta,
-         .arguments = {"29"_tb},
-         .extender = '?'},
+         .extender = '?',
+         .arguments = {"29"_tb}},
      R"(control_sequence[initiator:'[', command:'H', args:"29", extender:'?'])"             },
 };
 
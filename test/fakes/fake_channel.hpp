@@ -3,6 +3,7 @@
 #include <terminalpp/core.hpp>
 
 #include <functional>
+#include <cstddef>
 
 struct fake_channel
 {
@@ -21,6 +22,7 @@ struct fake_channel
     void write(terminalpp::bytes data)
     {
         written_.append(data.begin(), data.end());
+        ++write_count_;
     }
 
     //* =================================================================
@@ -44,6 +46,14 @@ struct fake_channel
         }
     }
 
+    //* =================================================================
+    /// \brief Returns whether the channel is under backpressure.
+    //* =================================================================
+    [[nodiscard]] bool is_backpressured() const
+    {
+        return backpressured_;
+    }
+
     //* =================================================================
     /// \brief Fakes receiving the passed data.
     //* =================================================================
@@ -60,5 +70,7 @@ struct fake_channel
 
     std::function<void(terminalpp::bytes)> read_callback_;
     terminalpp::byte_storage written_;
+    std::size_t write_count_{0};
     bool alive_{true};
+    bool backpressured_{false};
 };
\ No newline at end of file
@@ -69,6 +69,13 @@ constexpr mouse_event_test_data const mouse_event_strings[] = {
          .action_ = terminalpp::mouse::event_type::left_button_down,
          .position_ = {15, 17}},
      "mouse_event[point(15,17), lmb]"                                                                            },
+
+    // Reports with buttons and modifiers should output those too
+    {terminalpp::mouse::event{
+         .action_ = terminalpp::mouse::event_type::button_up,
+         .button_ = terminalpp::mouse::button::right,
+         .modifiers_ = terminalpp::vk_modifier::shift},
+     "mouse_event[point(0,0), up, right, shift]"                                                                 },
 };
 
 INSTANTIATE_TEST_SUITE_P(
@@ -0,0 +1,36 @@
+#include <gtest/gtest.h>
+#include <terminalpp/paste.hpp>
+
+#include <sstream>
+
+using namespace terminalpp::literals;  // NOLINT
+
+namespace {
+
+TEST(a_default_constructed_paste, has_no_text)
+{
+    terminalpp::paste const pst;
+    ASSERT_TRUE(pst.text.empty());
+}
+
+TEST(pastes, compare_equal_when_their_text_is_equal)
+{
+    auto const text = "text"_tb;
+    auto const same_text = "text"_tb;
+    auto const other_text = "other"_tb;
+
+    EXPECT_EQ(terminalpp::paste{text}, terminalpp::paste{same_text});
+    EXPECT_NE(terminalpp::paste{text}, terminalpp::paste{other_text});
+}
+
+TEST(a_paste, can_be_streamed_to_an_ostream)
+{
+    auto const text = "some text"_tb;
+
+    std::stringstream stream;
+    stream << terminalpp::paste{text};
+
+    ASSERT_EQ(R"(paste["some text"])", stream.str());
+}
+
+}  // namespace
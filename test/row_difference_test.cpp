@@ -0,0 +1,94 @@
+#include "terminalpp/detail/row_difference.hpp"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+#include <cstddef>
+
+using testing::Values;
+
+namespace {
+
+class a_row_difference_kernel
+  : public testing::TestWithParam<terminalpp::detail::row_difference_kernel>
+{
+protected:
+    void SetUp() override
+    {
+        if (!terminalpp::detail::is_supported(GetParam()))
+        {
+            GTEST_SKIP() << "kernel is not supported on this machine";
+        }
+    }
+
+    [[nodiscard]] std::size_t find_first_difference(
+        std::vector<terminalpp::element> const &lhs,
+        std::vector<terminalpp::element> const &rhs) const
+    {
+        return terminalpp::detail::find_first_difference(GetParam(), lhs, rhs);
+    }
+};
+
+TEST_P(a_row_difference_kernel, finds_no_difference_in_empty_rows)
+{
+    ASSERT_EQ(0U, find_first_difference({}, {}));
+}
+
+TEST_P(a_row_difference_kernel, finds_no_difference_in_identical_rows)
+{
+    std::vector<terminalpp::element> const row(100, {'x'});
+
+    ASSERT_EQ(row.size(), find_first_difference(row, row));
+}
+
+TEST_P(a_row_difference_kernel, finds_the_first_difference_at_any_position)
+{
+    std::vector<terminalpp::element> const row(67, {'x'});
+
+    for (std::size_t index = 0; index < row.size(); ++index)
+    {
+        auto changed = row;
+        changed[index].attribute_.intensity_ =
+            terminalpp::graphics::intensity::bold;
+
+        EXPECT_EQ(index, find_first_difference(row, changed));
+        EXPECT_EQ(index, find_first_difference(changed, row));
+    }
+}
+
+TEST_P(a_row_difference_kernel, compares_only_the_length_of_the_shorter_row)
+{
+    std::vector<terminalpp::element> const lhs(10, {'x'});
+    std::vector<terminalpp::element> const rhs(20, {'x'});
+
+    ASSERT_EQ(10U, find_first_difference(lhs, rhs));
+}
+
+TEST_P(a_row_difference_kernel, ignores_bytes_that_do_not_affect_equality)
+{
+    std::vector<terminalpp::element> const row(40, {'x'});
+    auto changed = row;
+
+    // The unused bytes of a non-UTF-8 glyph do not take part in comparisons.
+    changed[5].glyph_.ucharacter_[2] = 0xFF;
+    changed[35].glyph_.ucharacter_[1] = 0xFF;
+    changed[37].glyph_ = 'y';
+
+    ASSERT_EQ(37U, find_first_difference(row, changed));
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    row_difference_kernels_find_differences,
+    a_row_difference_kernel,
+    Values(
+        terminalpp::detail::row_difference_kernel::scalar,
+        terminalpp::detail::row_difference_kernel::sse2,
+        terminalpp::detail::row_difference_kernel::avx2));
+
+TEST(row_difference_kernel_selection, selects_a_supported_kernel)
+{
+    ASSERT_TRUE(terminalpp::detail::is_supported(
+        terminalpp::detail::select_row_difference_kernel()));
+}
+
+}  // namespace
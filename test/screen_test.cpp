@@ -4,6 +4,8 @@
 
 #include <gmock/gmock.h>
 
+#include <algorithm>
+
 using namespace terminalpp::literals;  // NOLINT
 using testing::ContainerEq;
 
@@ -145,4 +147,306 @@ TEST_F(a_screen, drawing_consecutive_elements_does_not_write_cursor_moves)
     EXPECT_THAT(channel_.written_, ContainerEq(reference_channel_.written_));
 }
 
+TEST_F(a_screen, drawing_runs_of_elements_moves_the_cursor_once_per_run)
+{
+    fill_canvas();
+
+    // Give the element between the runs a different attribute so that it
+    // cannot be cheaply rewritten.
+    canvas_[2][1].attribute_.intensity_ = terminalpp::graphics::intensity::bold;
+    screen_.draw(canvas_);
+    channel_.written_.clear();
+
+    canvas_[0][1] = 'v';
+    canvas_[1][1] = 'w';
+    canvas_[3][1] = 'x';
+    canvas_[4][1] = 'y';
+    canvas_[1][2] = 'z';
+
+    reference_terminal_ << terminalpp::move_cursor({0, 1})
+                        << terminalpp::element{'v'} << terminalpp::element{'w'}
+                        << terminalpp::move_cursor({3, 1})
+                        << terminalpp::element{'x'} << terminalpp::element{'y'}
+                        << terminalpp::move_cursor({1, 2})
+                        << terminalpp::element{'z'};
+
+    screen_.draw(canvas_);
+    EXPECT_THAT(channel_.written_, ContainerEq(reference_channel_.written_));
+}
+
+TEST_F(a_screen, drawing_runs_separated_by_a_short_gap_rewrites_the_gap)
+{
+    fill_canvas();
+    screen_.draw(canvas_);
+    channel_.written_.clear();
+
+    canvas_[0][1] = 'v';
+    canvas_[3][1] = 'w';
+
+    reference_terminal_ << terminalpp::move_cursor({0, 1})
+                        << terminalpp::element{'v'} << canvas_[1][1]
+                        << canvas_[2][1] << terminalpp::element{'w'};
+
+    screen_.draw(canvas_);
+    EXPECT_THAT(channel_.written_, ContainerEq(reference_channel_.written_));
+}
+
+TEST_F(a_screen, drawing_runs_separated_by_a_long_gap_moves_the_cursor)
+{
+    fill_canvas();
+    screen_.draw(canvas_);
+    channel_.written_.clear();
+
+    canvas_[0][1] = 'v';
+    canvas_[4][1] = 'w';
+
+    reference_terminal_ << terminalpp::move_cursor({0, 1})
+                        << terminalpp::element{'v'}
+                        << terminalpp::move_cursor({4, 1})
+                        << terminalpp::element{'w'};
+
+    screen_.draw(canvas_);
+    EXPECT_THAT(channel_.written_, ContainerEq(reference_channel_.written_));
+}
+
+TEST_F(a_screen, has_an_empty_back_buffer)
+{
+    EXPECT_EQ(terminalpp::extent{}, screen_.back_buffer().size());
+}
+
+TEST_F(a_screen, presenting_the_back_buffer_draws_its_differences)
+{
+    auto &back_buffer = screen_.back_buffer();
+    back_buffer.resize(size_);
+    fill_canvas();
+    std::ranges::copy(canvas_, back_buffer.begin());
+
+    screen_.present();
+    channel_.written_.clear();
+
+    back_buffer[2][3] = 'x';
+
+    reference_terminal_ << terminalpp::move_cursor({2, 3})
+                        << terminalpp::element{'x'};
+
+    screen_.present();
+    EXPECT_THAT(channel_.written_, ContainerEq(reference_channel_.written_));
+}
+
+TEST_F(a_screen, presenting_an_unchanged_back_buffer_draws_nothing)
+{
+    auto &back_buffer = screen_.back_buffer();
+    back_buffer.resize(size_);
+    back_buffer[1][1] = 'x';
+
+    screen_.present();
+    channel_.written_.clear();
+
+    screen_.present();
+    EXPECT_THAT(channel_.written_, ContainerEq(""_tb));
+}
+
+TEST_F(a_screen, presenting_the_back_buffer_skips_clean_regions)
+{
+    auto &back_buffer = screen_.back_buffer();
+    back_buffer.resize(size_);
+    screen_.present();
+    channel_.written_.clear();
+
+    // Changes that are not marked as dirty are not noticed.
+    back_buffer[2][3] = 'x';
+    back_buffer.mark_clean();
+
+    screen_.present();
+    EXPECT_THAT(channel_.written_, ContainerEq(""_tb));
+}
+
+TEST_F(
+    a_screen, presenting_after_drawing_another_canvas_redraws_the_back_buffer)
+{
+    auto &back_buffer = screen_.back_buffer();
+    back_buffer.resize(size_);
+    screen_.present();
+
+    canvas_[2][3] = 'x';
+    screen_.draw(canvas_);
+    channel_.written_.clear();
+
+    reference_terminal_ << terminalpp::move_cursor({3, 3});
+    reference_channel_.written_.clear();
+    reference_terminal_ << terminalpp::move_cursor({2, 3})
+                        << terminalpp::element{' '};
+
+    screen_.present();
+    EXPECT_THAT(channel_.written_, ContainerEq(reference_channel_.written_));
+}
+
+TEST_F(a_screen, with_a_flush_threshold_draws_a_frame_in_a_single_write)
+{
+    fill_canvas();
+    terminal_.set_flush_threshold(4096);
+    channel_.write_count_ = 0;
+
+    screen_.draw(canvas_);
+
+    EXPECT_FALSE(channel_.written_.empty());
+    EXPECT_EQ(1U, channel_.write_count_);
+}
+
+class a_screen_with_frame_skipping : public a_screen
+{
+public:
+    a_screen_with_frame_skipping() : back_buffer_(screen_.back_buffer())
+    {
+        screen_.set_frame_skipping(true);
+        fill_canvas();
+        back_buffer_.resize(size_);
+        std::ranges::copy(canvas_, back_buffer_.begin());
+        screen_.present();
+        channel_.written_.clear();
+    }
+
+protected:
+    terminalpp::canvas &back_buffer_;
+};
+
+TEST_F(
+    a_screen_with_frame_skipping,
+    presents_frames_when_not_under_backpressure)
+{
+    back_buffer_[2][3] = 'x';
+
+    reference_terminal_ << terminalpp::move_cursor({2, 3})
+                        << terminalpp::element{'x'};
+
+    screen_.present();
+    EXPECT_THAT(channel_.written_, ContainerEq(reference_channel_.written_));
+    EXPECT_FALSE(screen_.has_pending_frame());
+}
+
+TEST_F(a_screen_with_frame_skipping, skips_frames_while_under_backpressure)
+{
+    channel_.backpressured_ = true;
+    back_buffer_[2][3] = 'x';
+
+    screen_.present();
+    EXPECT_THAT(channel_.written_, ContainerEq(""_tb));
+    EXPECT_TRUE(screen_.has_pending_frame());
+}
+
+TEST_F(
+    a_screen_with_frame_skipping,
+    does_not_draw_the_pending_frame_while_under_backpressure)
+{
+    channel_.backpressured_ = true;
+    back_buffer_[2][3] = 'x';
+    screen_.present();
+
+    screen_.draw_pending_frame();
+    EXPECT_THAT(channel_.written_, ContainerEq(""_tb));
+    EXPECT_TRUE(screen_.has_pending_frame());
+}
+
+TEST_F(
+    a_screen_with_frame_skipping,
+    draws_the_net_difference_of_skipped_frames_once_relieved)
+{
+    channel_.backpressured_ = true;
+    back_buffer_[1][1] = 'x';
+    screen_.present();
+
+    // The second frame reverts the first frame's change, and so only its
+    // own change is a difference from what was actually sent.
+    back_buffer_[1][1] = 'g';
+    back_buffer_[2][3] = 'y';
+    screen_.present();
+
+    channel_.backpressured_ = false;
+
+    reference_terminal_ << terminalpp::move_cursor({2, 3})
+                        << terminalpp::element{'y'};
+
+    screen_.draw_pending_frame();
+    EXPECT_THAT(channel_.written_, ContainerEq(reference_channel_.written_));
+    EXPECT_FALSE(screen_.has_pending_frame());
+}
+
+TEST_F(
+    a_screen_with_frame_skipping,
+    accumulates_the_dirty_regions_of_skipped_frames)
+{
+    channel_.backpressured_ = true;
+    back_buffer_[1][1] = 'x';
+    screen_.present();
+    back_buffer_[2][3] = 'y';
+    screen_.present();
+
+    channel_.backpressured_ = false;
+
+    reference_terminal_ << terminalpp::move_cursor({1, 1})
+                        << terminalpp::element{'x'}
+                        << terminalpp::move_cursor({2, 3})
+                        << terminalpp::element{'y'};
+
+    screen_.draw_pending_frame();
+    EXPECT_THAT(channel_.written_, ContainerEq(reference_channel_.written_));
+    EXPECT_FALSE(screen_.has_pending_frame());
+}
+
+TEST_F(a_screen_with_frame_skipping, always_draws_a_canvas_immediately)
+{
+    channel_.backpressured_ = true;
+    canvas_[2][3] = 'x';
+
+    reference_terminal_ << terminalpp::move_cursor({2, 3})
+                        << terminalpp::element{'x'};
+
+    screen_.draw(canvas_);
+    EXPECT_THAT(channel_.written_, ContainerEq(reference_channel_.written_));
+    EXPECT_FALSE(screen_.has_pending_frame());
+}
+
+TEST_F(a_screen_with_frame_skipping, supersedes_a_pending_frame_with_a_canvas)
+{
+    channel_.backpressured_ = true;
+    back_buffer_[1][1] = 'x';
+    screen_.present();
+    ASSERT_TRUE(screen_.has_pending_frame());
+
+    screen_.draw(canvas_);
+    EXPECT_FALSE(screen_.has_pending_frame());
+}
+
+TEST_F(a_screen, does_not_skip_frames_by_default)
+{
+    auto &back_buffer = screen_.back_buffer();
+    back_buffer.resize(size_);
+
+    channel_.backpressured_ = true;
+    back_buffer[2][3] = 'x';
+
+    screen_.present();
+    EXPECT_FALSE(channel_.written_.empty());
+    EXPECT_FALSE(screen_.has_pending_frame());
+}
+
+TEST(a_screen_of_a_known_terminal_type, draws_to_the_terminal)
+{
+    fake_channel channel;
+    terminalpp::basic_terminal<fake_channel> terminal{channel};
+    terminalpp::basic_screen<terminalpp::basic_terminal<fake_channel>> screen{
+        terminal};
+    terminalpp::canvas canvas{{5, 5}};
+    canvas[2][3] = 'x';
+
+    fake_channel reference_channel;
+    terminalpp::terminal reference_terminal{reference_channel};
+    terminalpp::screen reference_screen{reference_terminal};
+    reference_screen.draw(canvas);
+
+    screen.draw(canvas);
+    EXPECT_THAT(channel.written_, ContainerEq(reference_channel.written_));
+    EXPECT_FALSE(channel.written_.empty());
+}
+
 }  // namespace
@@ -0,0 +1,331 @@
+#include "terminalpp/socket_channel.hpp"
+
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <gmock/gmock.h>
+
+#include <array>
+#include <optional>
+#include <system_error>
+#include <tuple>
+#include <vector>
+
+using namespace terminalpp::literals;  // NOLINT
+using testing::ContainerEq;
+using testing::ElementsAre;
+
+namespace {
+
+class a_socket_channel : public testing::Test
+{
+protected:
+    a_socket_channel()
+    {
+        std::array<int, 2> fds{};
+        EXPECT_EQ(0, ::socketpair(AF_UNIX, SOCK_STREAM, 0, fds.data()));
+        peer_ = fds[1];
+        ::fcntl(peer_, F_SETFL, ::fcntl(peer_, F_GETFL) | O_NONBLOCK);
+
+        channel_.emplace(
+            loop_,
+            fds[0],
+            terminalpp::output_watermarks{
+                .high = 64, .low = 16, .capacity = 1024 * 1024});
+        channel_->on_backpressure([this](bool backpressured) {
+            backpressure_.push_back(backpressured);
+        });
+    }
+
+    ~a_socket_channel() override
+    {
+        channel_.reset();
+        ::close(peer_);
+    }
+
+    terminalpp::byte_storage read_peer()
+    {
+        terminalpp::byte_storage result;
+        std::array<terminalpp::byte, 4096> buffer{};
+
+        for (;;)
+        {
+            auto const count = ::read(peer_, buffer.data(), buffer.size());
+
+            if (count <= 0)
+            {
+                return result;
+            }
+
+            result.append(
+                buffer.data(), buffer.data() + static_cast<size_t>(count));
+        }
+    }
+
+    // Writes through the channel until the socket stops accepting data.
+    // The writes are small so that the data left queued is below the high
+    // watermark.
+    void fill_socket()
+    {
+        std::array<terminalpp::byte, 16> const buffer{};
+
+        while (channel_->pending() == 0)
+        {
+            channel_->write({buffer.data(), buffer.size()});
+        }
+    }
+
+    terminalpp::epoll_loop loop_;
+    int peer_{-1};
+    std::optional<terminalpp::socket_channel> channel_;
+    std::vector<bool> backpressure_;
+};
+
+TEST_F(a_socket_channel, writes_data_to_the_socket)
+{
+    channel_->write("hello"_tb);
+
+    EXPECT_THAT(read_peer(), ContainerEq("hello"_tb));
+    EXPECT_EQ(0U, channel_->pending());
+    EXPECT_TRUE(channel_->is_alive());
+}
+
+TEST_F(a_socket_channel, writes_fragments_to_the_socket_in_order)
+{
+    std::array const storage = {"hello"_tb, ", "_tb, "world"_tb};
+    std::vector<terminalpp::bytes> const fragments(
+        storage.begin(), storage.end());
+    channel_->write(fragments);
+
+    EXPECT_THAT(read_peer(), ContainerEq("hello, world"_tb));
+    EXPECT_EQ(0U, channel_->pending());
+}
+
+TEST_F(a_socket_channel, dispatches_input_to_a_requested_read_from_the_loop)
+{
+    std::optional<terminalpp::byte_storage> result;
+    channel_->async_read([&](terminalpp::bytes data) {
+        result.emplace(data.begin(), data.end());
+    });
+
+    EXPECT_EQ(0U, loop_.poll());
+
+    ASSERT_EQ(5, ::write(peer_, "input", 5));
+    EXPECT_EQ(1U, loop_.poll());
+
+    ASSERT_TRUE(result.has_value());
+    EXPECT_THAT(*result, ContainerEq("input"_tb));
+}
+
+TEST_F(a_socket_channel, does_not_read_when_no_read_is_requested)
+{
+    ASSERT_EQ(5, ::write(peer_, "input", 5));
+    EXPECT_EQ(0U, loop_.poll());
+}
+
+TEST_F(a_socket_channel, dies_when_the_peer_closes)
+{
+    std::optional<terminalpp::byte_storage> result;
+    channel_->async_read([&](terminalpp::bytes data) {
+        result.emplace(data.begin(), data.end());
+    });
+
+    ::close(peer_);
+    peer_ = -1;
+    EXPECT_EQ(1U, loop_.poll());
+
+    ASSERT_TRUE(result.has_value());
+    EXPECT_TRUE(result->empty());
+    EXPECT_FALSE(channel_->is_alive());
+}
+
+TEST_F(a_socket_channel, dies_when_the_peer_closes_with_no_read_requested)
+{
+    ::close(peer_);
+    peer_ = -1;
+
+    EXPECT_EQ(1U, loop_.poll());
+    EXPECT_FALSE(channel_->is_alive());
+    EXPECT_EQ(0U, loop_.poll());
+}
+
+TEST_F(a_socket_channel, calls_back_an_outstanding_read_when_closed)
+{
+    std::optional<terminalpp::byte_storage> result;
+    channel_->async_read([&](terminalpp::bytes data) {
+        result.emplace(data.begin(), data.end());
+    });
+
+    channel_->close();
+
+    ASSERT_TRUE(result.has_value());
+    EXPECT_TRUE(result->empty());
+    EXPECT_FALSE(channel_->is_alive());
+}
+
+TEST_F(a_socket_channel, reports_backpressure_when_the_peer_is_slow)
+{
+    fill_socket();
+    EXPECT_FALSE(channel_->is_backpressured());
+
+    std::array<terminalpp::byte, 64> const buffer{};
+    channel_->write({buffer.data(), buffer.size()});
+
+    EXPECT_TRUE(channel_->is_backpressured());
+    EXPECT_THAT(backpressure_, ElementsAre(true));
+}
+
+TEST_F(a_socket_channel, relieves_backpressure_once_the_queue_drains)
+{
+    fill_socket();
+
+    std::array<terminalpp::byte, 64> const buffer{};
+    channel_->write({buffer.data(), buffer.size()});
+
+    do
+    {
+        std::ignore = read_peer();
+    } while (loop_.poll() != 0 && channel_->pending() != 0);
+
+    EXPECT_EQ(0U, channel_->pending());
+    EXPECT_FALSE(channel_->is_backpressured());
+    EXPECT_THAT(backpressure_, ElementsAre(true, false));
+}
+
+TEST_F(a_socket_channel, sends_queued_data_in_order)
+{
+    fill_socket();
+    auto const queued = channel_->pending();
+
+    channel_->write("end"_tb);
+
+    terminalpp::byte_storage received;
+
+    do
+    {
+        received += read_peer();
+    } while (loop_.poll() != 0 || channel_->pending() != 0);
+
+    received += read_peer();
+    ASSERT_GE(received.size(), queued + 3);
+    EXPECT_THAT(received.substr(received.size() - 3), ContainerEq("end"_tb));
+}
+
+TEST_F(a_socket_channel, relieves_backpressure_when_it_dies)
+{
+    fill_socket();
+
+    std::array<terminalpp::byte, 64> const buffer{};
+    channel_->write({buffer.data(), buffer.size()});
+
+    channel_->close();
+
+    EXPECT_FALSE(channel_->is_backpressured());
+    EXPECT_THAT(backpressure_, ElementsAre(true, false));
+}
+
+TEST_F(a_socket_channel, may_be_destroyed_by_a_read_when_a_flush_fails)
+{
+    fill_socket();
+
+    std::array<terminalpp::byte, 64> const buffer{};
+    channel_->write({buffer.data(), buffer.size()});
+
+    auto reads = 0;
+    channel_->async_read([this, &reads](terminalpp::bytes data) {
+        EXPECT_TRUE(data.empty());
+        ++reads;
+        channel_.reset();
+    });
+
+    // The queued output can no longer be sent, and so the channel dies
+    // while flushing it.
+    ::close(peer_);
+    peer_ = -1;
+    EXPECT_EQ(1U, loop_.poll());
+
+    EXPECT_EQ(1, reads);
+    EXPECT_FALSE(channel_.has_value());
+    EXPECT_THAT(backpressure_, ElementsAre(true, false));
+}
+
+TEST_F(a_socket_channel, may_be_destroyed_by_a_read_when_closed)
+{
+    auto reads = 0;
+    channel_->async_read([this, &reads](terminalpp::bytes data) {
+        EXPECT_TRUE(data.empty());
+        ++reads;
+        channel_.reset();
+    });
+
+    channel_->close();
+
+    EXPECT_EQ(1, reads);
+    EXPECT_FALSE(channel_.has_value());
+}
+
+TEST(a_socket_channel_with_a_small_capacity, dies_when_the_capacity_is_exceeded)
+{
+    std::array<int, 2> fds{};
+    ASSERT_EQ(0, ::socketpair(AF_UNIX, SOCK_STREAM, 0, fds.data()));
+
+    terminalpp::epoll_loop loop;
+    terminalpp::socket_channel channel{
+        loop, fds[0], {.high = 64, .low = 16, .capacity = 128}
+    };
+
+    std::array<terminalpp::byte, 4096> const buffer{};
+
+    for (auto count = 0; count < 1024 && channel.is_alive(); ++count)
+    {
+        channel.write({buffer.data(), buffer.size()});
+    }
+
+    EXPECT_FALSE(channel.is_alive());
+    EXPECT_EQ(0U, channel.pending());
+
+    ::close(fds[1]);
+}
+
+TEST(a_socket_channel_with_an_invalid_socket, throws_on_construction)
+{
+    terminalpp::epoll_loop loop;
+
+    EXPECT_THROW(terminalpp::socket_channel(loop, -1), std::system_error);
+}
+
+TEST(an_epoll_loop, does_not_service_a_channel_destroyed_during_dispatch)
+{
+    std::array<int, 2> first{};
+    std::array<int, 2> second{};
+    ASSERT_EQ(0, ::socketpair(AF_UNIX, SOCK_STREAM, 0, first.data()));
+    ASSERT_EQ(0, ::socketpair(AF_UNIX, SOCK_STREAM, 0, second.data()));
+
+    terminalpp::epoll_loop loop;
+    std::optional<terminalpp::socket_channel> channels[2];
+    channels[0].emplace(loop, first[0]);
+    channels[1].emplace(loop, second[0]);
+
+    // Whichever channel is serviced first destroys the other.
+    auto reads = 0;
+    channels[0]->async_read([&](terminalpp::bytes) {
+        ++reads;
+        channels[1].reset();
+    });
+    channels[1]->async_read([&](terminalpp::bytes) {
+        ++reads;
+        channels[0].reset();
+    });
+
+    ASSERT_EQ(1, ::write(first[1], "x", 1));
+    ASSERT_EQ(1, ::write(second[1], "x", 1));
+
+    EXPECT_EQ(1U, loop.poll());
+    EXPECT_EQ(1, reads);
+
+    ::close(first[1]);
+    ::close(second[1]);
+}
+
+}  // namespace
@@ -0,0 +1,253 @@
+#include "terminalpp/stdout_channel.hpp"
+
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <gmock/gmock.h>
+
+#include <array>
+#include <optional>
+#include <tuple>
+#include <vector>
+#include <cstdlib>
+
+using namespace terminalpp::literals;  // NOLINT
+using testing::ContainerEq;
+
+namespace {
+
+class a_stdout_channel : public testing::Test
+{
+protected:
+    a_stdout_channel()
+    {
+        EXPECT_EQ(0, ::pipe(input_.data()));
+        EXPECT_EQ(0, ::pipe(output_.data()));
+        channel_.emplace(input_[0], output_[1]);
+    }
+
+    ~a_stdout_channel() override
+    {
+        channel_.reset();
+
+        for (auto const fd : {input_[0], input_[1], output_[0], output_[1]})
+        {
+            ::close(fd);
+        }
+    }
+
+    terminalpp::byte_storage read_output()
+    {
+        terminalpp::byte_storage result;
+        std::array<terminalpp::byte, 4096> buffer{};
+
+        for (;;)
+        {
+            auto const count =
+                ::read(output_[0], buffer.data(), buffer.size());
+
+            if (count <= 0)
+            {
+                return result;
+            }
+
+            result.append(
+                buffer.data(), buffer.data() + static_cast<size_t>(count));
+        }
+    }
+
+    void fill_output()
+    {
+        ::fcntl(output_[0], F_SETFL, ::fcntl(output_[0], F_GETFL) | O_NONBLOCK);
+
+        std::array<terminalpp::byte, 4096> const buffer{};
+
+        while (::write(output_[1], buffer.data(), buffer.size()) > 0)
+        {
+        }
+    }
+
+    std::array<int, 2> input_{};
+    std::array<int, 2> output_{};
+    std::optional<terminalpp::stdout_channel> channel_;
+};
+
+TEST_F(a_stdout_channel, writes_data_to_its_output)
+{
+    channel_->write("hello"_tb);
+    ::fcntl(output_[0], F_SETFL, ::fcntl(output_[0], F_GETFL) | O_NONBLOCK);
+
+    EXPECT_THAT(read_output(), ContainerEq("hello"_tb));
+    EXPECT_EQ(0U, channel_->pending());
+    EXPECT_TRUE(channel_->is_alive());
+}
+
+TEST_F(a_stdout_channel, queues_data_that_cannot_be_written_and_sends_it_later)
+{
+    fill_output();
+
+    channel_->write("hello, "_tb);
+    channel_->write("world"_tb);
+    EXPECT_EQ(12U, channel_->pending());
+    EXPECT_TRUE(channel_->is_backpressured());
+
+    // Draining the filler frees space in the pipe for the queued data.
+    std::ignore = read_output();
+    EXPECT_TRUE(channel_->poll());
+
+    EXPECT_EQ(0U, channel_->pending());
+    EXPECT_FALSE(channel_->is_backpressured());
+    EXPECT_THAT(read_output(), ContainerEq("hello, world"_tb));
+}
+
+TEST_F(a_stdout_channel, writes_fragments_in_order)
+{
+    std::array const storage = {"hello"_tb, ", "_tb, "world"_tb};
+    std::vector<terminalpp::bytes> const fragments(
+        storage.begin(), storage.end());
+    channel_->write(fragments);
+    ::fcntl(output_[0], F_SETFL, ::fcntl(output_[0], F_GETFL) | O_NONBLOCK);
+
+    EXPECT_THAT(read_output(), ContainerEq("hello, world"_tb));
+}
+
+TEST_F(a_stdout_channel, queues_fragments_behind_queued_data)
+{
+    fill_output();
+
+    channel_->write("hello"_tb);
+
+    std::array const storage = {", "_tb, "world"_tb};
+    std::vector<terminalpp::bytes> const fragments(
+        storage.begin(), storage.end());
+    channel_->write(fragments);
+    EXPECT_EQ(12U, channel_->pending());
+
+    std::ignore = read_output();
+    EXPECT_TRUE(channel_->poll());
+
+    EXPECT_THAT(read_output(), ContainerEq("hello, world"_tb));
+}
+
+TEST_F(a_stdout_channel, does_not_poll_when_there_is_nothing_to_do)
+{
+    EXPECT_FALSE(channel_->poll());
+}
+
+TEST_F(a_stdout_channel, dispatches_input_to_a_requested_read)
+{
+    std::optional<terminalpp::byte_storage> result;
+    channel_->async_read([&](terminalpp::bytes data) {
+        result.emplace(data.begin(), data.end());
+    });
+
+    EXPECT_FALSE(channel_->poll());
+    EXPECT_FALSE(result.has_value());
+
+    ASSERT_EQ(5, ::write(input_[1], "input", 5));
+    EXPECT_TRUE(channel_->poll());
+
+    ASSERT_TRUE(result.has_value());
+    EXPECT_THAT(*result, ContainerEq("input"_tb));
+}
+
+TEST_F(a_stdout_channel, dies_when_its_input_ends)
+{
+    std::optional<terminalpp::byte_storage> result;
+    channel_->async_read([&](terminalpp::bytes data) {
+        result.emplace(data.begin(), data.end());
+    });
+
+    ::close(input_[1]);
+    input_[1] = -1;
+    EXPECT_TRUE(channel_->poll());
+
+    ASSERT_TRUE(result.has_value());
+    EXPECT_TRUE(result->empty());
+    EXPECT_FALSE(channel_->is_alive());
+}
+
+TEST_F(a_stdout_channel, calls_back_an_outstanding_read_when_closed)
+{
+    std::optional<terminalpp::byte_storage> result;
+    channel_->async_read([&](terminalpp::bytes data) {
+        result.emplace(data.begin(), data.end());
+    });
+
+    channel_->close();
+
+    ASSERT_TRUE(result.has_value());
+    EXPECT_TRUE(result->empty());
+    EXPECT_FALSE(channel_->is_alive());
+}
+
+TEST_F(a_stdout_channel, calls_back_a_read_requested_after_it_has_died)
+{
+    channel_->close();
+
+    std::optional<terminalpp::byte_storage> result;
+    channel_->async_read([&](terminalpp::bytes data) {
+        result.emplace(data.begin(), data.end());
+    });
+
+    ASSERT_TRUE(result.has_value());
+    EXPECT_TRUE(result->empty());
+}
+
+TEST_F(a_stdout_channel, restores_the_modes_of_its_descriptors_on_destruction)
+{
+    channel_.reset();
+
+    EXPECT_EQ(0, ::fcntl(input_[0], F_GETFL) & O_NONBLOCK);
+    EXPECT_EQ(0, ::fcntl(output_[1], F_GETFL) & O_NONBLOCK);
+}
+
+TEST(a_raw_mode, does_nothing_for_a_descriptor_that_is_not_a_tty)
+{
+    std::array<int, 2> fds{};
+    ASSERT_EQ(0, ::pipe(fds.data()));
+
+    {
+        terminalpp::raw_mode const raw{fds[0]};
+        EXPECT_FALSE(raw.is_active());
+    }
+
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+
+TEST(a_raw_mode, places_a_tty_into_raw_mode_and_restores_it)
+{
+    auto const master = ::posix_openpt(O_RDWR | O_NOCTTY);
+
+    if (master < 0 || ::grantpt(master) != 0 || ::unlockpt(master) != 0)
+    {
+        GTEST_SKIP() << "pseudo-terminals are not available";
+    }
+
+    auto const slave = ::open(::ptsname(master), O_RDWR | O_NOCTTY);
+    ASSERT_NE(-1, slave);
+
+    termios original{};
+    ::tcgetattr(slave, &original);
+
+    {
+        terminalpp::raw_mode const raw{slave};
+        EXPECT_TRUE(raw.is_active());
+
+        termios current{};
+        ::tcgetattr(slave, &current);
+        EXPECT_EQ(0U, current.c_lflag & tcflag_t{ICANON | ECHO});
+    }
+
+    termios restored{};
+    ::tcgetattr(slave, &restored);
+    EXPECT_EQ(original.c_lflag, restored.c_lflag);
+    EXPECT_EQ(original.c_iflag, restored.c_iflag);
+
+    ::close(slave);
+    ::close(master);
+}
+
+}  // namespace
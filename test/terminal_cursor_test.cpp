@@ -38,10 +38,11 @@ TEST_P(a_terminal_with_an_unknown_location, sends_bytes_when_moving_the_cursor)
 }
 
 constexpr unknown_location_move_data unknown_location_move_data_table[] = {
-    {{0, 0}, "\x1B[H"_tb   },
-    {{0, 4}, "\x1B[5H"_tb  },
-    {{2, 0}, "\x1B[1;3H"_tb},
-    {{2, 4}, "\x1B[5;3H"_tb},
+    {{0, 0},     "\x1B[H"_tb       },
+    {{0, 4},     "\x1B[5H"_tb      },
+    {{2, 0},     "\x1B[1;3H"_tb    },
+    {{2, 4},     "\x1B[5;3H"_tb    },
+    {{123, 456}, "\x1B[457;124H"_tb},
 };
 
 INSTANTIATE_TEST_SUITE_P(
@@ -86,23 +87,38 @@ constexpr known_location_move_data known_location_move_data_table[] = {
     {{7, 6},   {7, 6},   ""_tb         },
 
     // Moving to the home location sends cursor position = home
-    {{10, 10}, {0, 0},   "\x1B[H"_tb   },
+    {{10, 10}, {0, 0},   "\x1B[H"_tb     },
 
-    // Moving in the current row sends cursor horizontal absolute
-    {{10, 10}, {0, 10},  "\x1B[G"_tb   },
-    {{20, 10}, {8, 10},  "\x1B[9G"_tb  },
-    {{8, 10},  {20, 10}, "\x1B[21G"_tb },
+    // Moving to the start of the current row sends carriage return
+    {{10, 10}, {0, 10},  "\r"_tb         },
+
+    // Moving a short distance left sends backspaces
+    {{10, 10}, {8, 10},  "\b\b"_tb       },
+
+    // Otherwise, moving in the current row sends cursor horizontal absolute
+    {{20, 10}, {8, 10},  "\x1B[9G"_tb    },
+    {{8, 10},  {20, 10}, "\x1B[21G"_tb   },
 
     // Moving up in rows sends cursor up
-    {{10, 10}, {10, 9},  "\x1B[A"_tb   },
-    {{10, 10}, {10, 8},  "\x1B[2A"_tb  },
+    {{10, 10}, {10, 9},  "\x1B[A"_tb     },
+    {{10, 10}, {10, 8},  "\x1B[2A"_tb    },
 
     // Moving down in rows sends cursor down
-    {{10, 10}, {10, 11}, "\x1B[B"_tb   },
-    {{10, 10}, {10, 12}, "\x1B[2B"_tb  },
+    {{10, 10}, {10, 11}, "\x1B[B"_tb     },
+    {{10, 10}, {10, 12}, "\x1B[2B"_tb    },
+
+    // Moving to the start of a following row sends carriage return and
+    // line feeds
+    {{10, 10}, {0, 11},  "\r\n"_tb       },
+    {{10, 10}, {0, 12},  "\r\n\n"_tb     },
+    {{10, 10}, {2, 11},  "\r\n\x1B[3G"_tb},
 
-    // Moving in any kind of diagonal way reverts to using cursor position
-    {{10, 10}, {5, 6},   "\x1B[7;6H"_tb},
+    // Moving a short distance diagonally combines relative movements
+    {{10, 10}, {9, 9},   "\x1B[A\b"_tb   },
+    {{10, 10}, {12, 11}, "\x1B[B\x1B[2C"_tb},
+
+    // Moving a long distance diagonally sends cursor position
+    {{10, 10}, {5, 6},   "\x1B[7;6H"_tb  },
 };
 
 INSTANTIATE_TEST_SUITE_P(
@@ -110,6 +126,72 @@ INSTANTIATE_TEST_SUITE_P(
     a_terminal_with_a_known_location,
     ValuesIn(known_location_move_data_table));
 
+class a_terminal_without_absolute_movement
+  : public testing::Test,
+    public terminal_test_base
+{
+public:
+    a_terminal_without_absolute_movement()
+      : terminal_test_base{[] {
+            terminalpp::behaviour behaviour;
+            behaviour.supports_cha = false;
+            behaviour.supports_vpa = false;
+            return behaviour;
+        }()}
+    {
+        terminal_.set_size({30, 30});
+    }
+};
+
+TEST_F(
+    a_terminal_without_absolute_movement,
+    does_not_send_cursor_horizontal_absolute)
+{
+    terminal_ << terminalpp::move_cursor({20, 10});
+    channel_.written_.clear();
+
+    terminal_ << terminalpp::move_cursor({8, 10});
+
+    EXPECT_THAT(channel_.written_, ContainerEq("\x1B[12D"_tb));
+}
+
+TEST_F(
+    a_terminal_without_absolute_movement,
+    does_not_send_line_position_absolute)
+{
+    terminal_ << terminalpp::move_cursor({3, 20});
+    channel_.written_.clear();
+
+    terminal_ << terminalpp::move_cursor({3, 1});
+
+    EXPECT_THAT(channel_.written_, ContainerEq("\x1B[19A"_tb));
+}
+
+class a_terminal_that_supports_a_default_cursor_position_row
+  : public testing::Test,
+    public terminal_test_base
+{
+public:
+    a_terminal_that_supports_a_default_cursor_position_row()
+      : terminal_test_base{[] {
+            terminalpp::behaviour behaviour;
+            behaviour.supports_cup_default_row = true;
+            return behaviour;
+        }()}
+    {
+        terminal_.set_size({30, 30});
+    }
+};
+
+TEST_F(
+    a_terminal_that_supports_a_default_cursor_position_row,
+    omits_the_row_when_moving_to_the_first_row)
+{
+    terminal_ << terminalpp::move_cursor({4, 0});
+
+    EXPECT_THAT(channel_.written_, ContainerEq("\x1B[;5H"_tb));
+}
+
 TEST_F(a_terminal, when_hiding_the_cursor_sends_ansi_codes)
 {
     terminal_ << terminalpp::hide_cursor();
@@ -1,13 +1,54 @@
 #include "fakes/fake_channel.hpp"
+#include "terminalpp/detail/parser.hpp"
 #include "terminalpp/terminal.hpp"
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <utility>
+#include <vector>
+#include <cstddef>
+#include <cstdlib>
+
 using namespace terminalpp::literals;  // NOLINT
 using testing::ValuesIn;
 
 namespace {
 
+// The number of allocations made through the global operator new, so that
+// tests can check that parsing does not allocate.
+std::size_t allocation_count = 0;
+
+}  // namespace
+
+void *operator new(std::size_t size)
+{
+    ++allocation_count;
+
+    if (auto *const memory = std::malloc(size == 0 ? 1 : size);
+        memory != nullptr)
+    {
+        return memory;
+    }
+
+    throw std::bad_alloc{};
+}
+
+void operator delete(void *memory) noexcept
+{
+    std::free(memory);  // NOLINT
+}
+
+void operator delete(void *memory, std::size_t /*size*/) noexcept
+{
+    std::free(memory);  // NOLINT
+}
+
+namespace {
+
 class terminal_read_test_base
 {
 public:
@@ -150,29 +191,29 @@ token_test_data const token_test_data_table[] = {
          .initiator = '[',
          .command = 'n',
          .meta = false,
-         .arguments = {"6"_tb},
-         .extender = '?'}}                                      },
+         .extender = '?',
+         .arguments = {"6"_tb}}}                                },
     {"\x1B[>5c"_tb,
      {terminalpp::control_sequence{
          .initiator = '[',
          .command = 'c',
          .meta = false,
-         .arguments = {"5"_tb},
-         .extender = '>'}}                                      },
+         .extender = '>',
+         .arguments = {"5"_tb}}}                                },
     {"\x1B[!p"_tb,
      {terminalpp::control_sequence{
          .initiator = '[',
          .command = 'p',
          .meta = false,
-         .arguments = {""_tb},
-         .extender = '!'}}                                      },
+         .extender = '!',
+         .arguments = {""_tb}}}                                 },
     {"\x9B!p"_tb,
      {terminalpp::control_sequence{
          .initiator = '[',
          .command = 'p',
          .meta = false,
-         .arguments = {""_tb},
-         .extender = '!'}}                                      },
+         .extender = '!',
+         .arguments = {""_tb}}}                                 },
 
     // ANSI mouse events are converted to the respective structure
     {"\x1B[M"_tb,      {}                                       },
@@ -185,6 +226,43 @@ token_test_data const token_test_data_table[] = {
          .action_ = terminalpp::mouse::event_type::middle_button_down,
          .position_ = {55, 19}}}                                },
 
+    // SGR mouse events are decoded from their parameters, so positions are
+    // not limited to 223, and releases and modifiers are reported.
+    {"\x1B[<0;301;42M"_tb,
+     {terminalpp::mouse::event{
+         .action_ = terminalpp::mouse::event_type::left_button_down,
+         .position_ = {300, 41},
+         .button_ = terminalpp::mouse::button::left}}          },
+    {"\x1B[<2;1;1m"_tb,
+     {terminalpp::mouse::event{
+         .action_ = terminalpp::mouse::event_type::button_up,
+         .position_ = {0, 0},
+         .button_ = terminalpp::mouse::button::right}}         },
+    {"\x1B[<20;5;6M"_tb,
+     {terminalpp::mouse::event{
+         .action_ = terminalpp::mouse::event_type::left_button_down,
+         .position_ = {4, 5},
+         .button_ = terminalpp::mouse::button::left,
+         .modifiers_ = terminalpp::vk_modifier::shift
+                     | terminalpp::vk_modifier::ctrl}}         },
+    {"\x1B[<33;10;20M"_tb,
+     {terminalpp::mouse::event{
+         .action_ = terminalpp::mouse::event_type::no_button_change,
+         .position_ = {9, 19},
+         .button_ = terminalpp::mouse::button::middle}}        },
+    {"\x1B[<35;10;20M"_tb,
+     {terminalpp::mouse::event{
+         .action_ = terminalpp::mouse::event_type::no_button_change,
+         .position_ = {9, 19}}}                                 },
+    {"\x1B[<65;3;4M"_tb,
+     {terminalpp::mouse::event{
+         .action_ = terminalpp::mouse::event_type::scrollwheel_down,
+         .position_ = {2, 3}}}                                  },
+    {"\x1B[<3;;M"_tb,
+     {terminalpp::mouse::event{
+         .action_ = terminalpp::mouse::event_type::button_up,
+         .position_ = {0, 0}}}                                  },
+
     // Cursor keys are converted to the respective virtual keys.
     {"\x1B[A"_tb,
      {terminalpp::virtual_key{
@@ -1003,6 +1081,31 @@ token_test_data const token_test_data_table[] = {
                  .command = 'S',
                  .meta = true,
                  .arguments = {""_tb}}}}                        },
+
+    // Unknown keypad codes and modifiers are not translated.
+    {"\x1B[16~"_tb,
+     {terminalpp::control_sequence{
+         .initiator = '[',
+         .command = '~',
+         .meta = false,
+         .arguments = {"16"_tb}}}                               },
+    {"\x1B[300~"_tb,
+     {terminalpp::control_sequence{
+         .initiator = '[',
+         .command = '~',
+         .meta = false,
+         .arguments = {"300"_tb}}}                              },
+    {"\x1B[6;300~"_tb,
+     {terminalpp::virtual_key{
+         .key = terminalpp::vk::pgdn,
+         .modifiers = terminalpp::vk_modifier::none,
+         .repeat_count = 1,
+         .sequence =
+             terminalpp::control_sequence{
+                 .initiator = '[',
+                 .command = '~',
+                 .meta = false,
+                 .arguments = {"6"_tb, "300"_tb}}}}             },
 };
 
 INSTANTIATE_TEST_SUITE_P(
@@ -1077,4 +1180,485 @@ INSTANTIATE_TEST_SUITE_P(
     a_terminal_reading_partial_input_tokens,
     ValuesIn(partial_token_test_data_table));
 
+class a_terminal_reading_input : public testing::Test,
+                                  public terminal_read_test_base
+{
+};
+
+TEST_F(a_terminal_reading_input, reuses_its_token_buffer_between_reads)
+{
+    terminalpp::token const *first_tokens = nullptr;
+    terminalpp::token const *second_tokens = nullptr;
+
+    terminal_.async_read([&first_tokens](terminalpp::tokens tokens) {
+        first_tokens = tokens.data();
+    });
+    channel_.receive("abc"_tb);
+
+    terminal_.async_read([&second_tokens](terminalpp::tokens tokens) {
+        second_tokens = tokens.data();
+    });
+    channel_.receive("de"_tb);
+
+    ASSERT_NE(nullptr, first_tokens);
+    ASSERT_EQ(first_tokens, second_tokens);
+}
+
+TEST_F(a_terminal_reading_input, can_read_again_from_within_a_read_callback)
+{
+    std::vector<terminalpp::token> result;
+
+    auto const append_to_result = [&result](terminalpp::tokens tokens) {
+        result.insert(result.end(), tokens.begin(), tokens.end());
+    };
+
+    terminal_.async_read([&](terminalpp::tokens tokens) {
+        terminal_.async_read(append_to_result);
+        channel_.receive("b"_tb);
+        append_to_result(tokens);
+    });
+    channel_.receive("a"_tb);
+
+    terminalpp::token const expected_b = terminalpp::virtual_key{
+        .key = terminalpp::vk::lowercase_b,
+        .modifiers = terminalpp::vk_modifier::none,
+        .repeat_count = 1,
+        .sequence = {'b'_tb}};
+    terminalpp::token const expected_a = terminalpp::virtual_key{
+        .key = terminalpp::vk::lowercase_a,
+        .modifiers = terminalpp::vk_modifier::none,
+        .repeat_count = 1,
+        .sequence = {'a'_tb}};
+
+    ASSERT_EQ(2U, result.size());
+    EXPECT_EQ(expected_b, result[0]);
+    EXPECT_EQ(expected_a, result[1]);
+}
+
+TEST(a_parser, parses_a_span_of_input_as_it_would_each_byte)
+{
+    auto const input =
+        "plain text\x1B[2Amore\r\ntext\x9B"
+        "5~\x8F"
+        "A\x1B[M!X4end"_tb;
+
+    terminalpp::detail::parser byte_parser;
+    std::vector<terminalpp::token> expected;
+
+    for (auto const ch : input)
+    {
+        if (auto result = byte_parser(ch); result.has_value())
+        {
+            expected.push_back(std::move(*result));
+        }
+    }
+
+    terminalpp::detail::parser span_parser;
+    std::vector<terminalpp::token> result;
+    span_parser.parse(input, std::back_inserter(result));
+
+    ASSERT_EQ(expected, result);
+}
+
+TEST(a_parser, parses_a_span_that_ends_within_a_sequence)
+{
+    terminalpp::detail::parser parser;
+    std::vector<terminalpp::token> result;
+
+    parser.parse("ab\x1B["_tb, std::back_inserter(result));
+    EXPECT_EQ(2U, result.size());
+
+    parser.parse("Bc"_tb, std::back_inserter(result));
+
+    terminalpp::token const expected = terminalpp::virtual_key{
+        .key = terminalpp::vk::cursor_down,
+        .modifiers = terminalpp::vk_modifier::none,
+        .repeat_count = 1,
+        .sequence = terminalpp::control_sequence{
+            .initiator = '[', .command = 'B', .arguments = {""_tb}}
+    };
+
+    ASSERT_EQ(4U, result.size());
+    EXPECT_EQ(expected, result[2]);
+}
+
+TEST(a_parser, treats_m_as_a_command_after_an_ss3_initializer)
+{
+    terminalpp::detail::parser parser;
+    std::vector<terminalpp::token> result;
+
+    parser.parse("\x1BOMx"_tb, std::back_inserter(result));
+
+    terminalpp::token const expected = terminalpp::virtual_key{
+        .key = terminalpp::vk::enter,
+        .modifiers = terminalpp::vk_modifier::none,
+        .repeat_count = 1,
+        .sequence = terminalpp::control_sequence{
+            .initiator = 'O', .command = 'M', .arguments = {""_tb}}
+    };
+
+    ASSERT_EQ(2U, result.size());
+    EXPECT_EQ(expected, result[0]);
+}
+
+TEST(a_parser, treats_an_unknown_mouse_button_as_no_button_change)
+{
+    terminalpp::detail::parser parser;
+    std::vector<terminalpp::token> result;
+
+    parser.parse("\x1B[M\x7F!\""_tb, std::back_inserter(result));
+
+    terminalpp::token const expected = terminalpp::mouse::event{
+        terminalpp::mouse::event_type::no_button_change, {0, 1}};
+
+    ASSERT_EQ(1U, result.size());
+    EXPECT_EQ(expected, result[0]);
+}
+
+TEST(a_parser, recognises_well_known_keys_from_the_numeric_parameters)
+{
+    terminalpp::detail::parser parser;
+    std::vector<terminalpp::token> result;
+
+    parser.parse("\x1B[24;5A\x1B[24;;5:1q"_tb, std::back_inserter(result));
+
+    terminalpp::token const expected_key = terminalpp::virtual_key{
+        .key = terminalpp::vk::cursor_up,
+        .modifiers = terminalpp::vk_modifier::ctrl,
+        .repeat_count = 24,
+        .sequence = terminalpp::control_sequence{
+            .initiator = '[', .command = 'A', .arguments = {"24"_tb, "5"_tb}}
+    };
+    terminalpp::token const expected_sequence = terminalpp::control_sequence{
+        .initiator = '[',
+        .command = 'q',
+        .arguments = {"24"_tb, ""_tb, "5:1"_tb}};
+
+    ASSERT_EQ(2U, result.size());
+    EXPECT_EQ(expected_key, result[0]);
+    EXPECT_EQ(expected_sequence, result[1]);
+}
+
+TEST(a_terminal_coalescing_mouse_motion, delivers_the_latest_motion_event)
+{
+    fake_channel channel;
+    terminalpp::terminal terminal{channel};
+    terminal.set_mouse_motion_coalescing(true);
+
+    std::vector<terminalpp::token> result;
+    terminal.async_read([&result](terminalpp::tokens tokens) {
+        result.assign(tokens.begin(), tokens.end());
+    });
+
+    channel.receive("\x1B[<35;1;1M\x1B[<35;2;1M\x1B[<35;3;1Mx"_tb);
+
+    terminalpp::token const expected_motion = terminalpp::mouse::event{
+        .action_ = terminalpp::mouse::event_type::no_button_change,
+        .position_ = {2, 0}};
+
+    ASSERT_EQ(2U, result.size());
+    EXPECT_EQ(expected_motion, result[0]);
+    EXPECT_TRUE(std::holds_alternative<terminalpp::virtual_key>(result[1]));
+}
+
+TEST(a_terminal_not_coalescing_mouse_motion, delivers_every_motion_event)
+{
+    fake_channel channel;
+    terminalpp::terminal terminal{channel};
+
+    std::vector<terminalpp::token> result;
+    terminal.async_read([&result](terminalpp::tokens tokens) {
+        result.assign(tokens.begin(), tokens.end());
+    });
+
+    channel.receive("\x1B[<35;1;1M\x1B[<35;2;1M\x1B[<35;3;1M"_tb);
+
+    ASSERT_EQ(3U, result.size());
+}
+
+TEST(a_terminal_coalescing_key_repeats, delivers_one_key_per_run)
+{
+    fake_channel channel;
+    terminalpp::terminal terminal{channel};
+    terminal.set_key_repeat_coalescing(true);
+
+    std::vector<terminalpp::token> result;
+    terminal.async_read([&result](terminalpp::tokens tokens) {
+        result.assign(tokens.begin(), tokens.end());
+    });
+
+    channel.receive("xxx\x1B[A\x1B[Ax"_tb);
+
+    ASSERT_EQ(3U, result.size());
+    EXPECT_EQ(3, std::get<terminalpp::virtual_key>(result[0]).repeat_count);
+    EXPECT_EQ(
+        terminalpp::vk::cursor_up,
+        std::get<terminalpp::virtual_key>(result[1]).key);
+    EXPECT_EQ(2, std::get<terminalpp::virtual_key>(result[1]).repeat_count);
+    EXPECT_EQ(1, std::get<terminalpp::virtual_key>(result[2]).repeat_count);
+}
+
+class a_terminal_reading_pastes : public testing::Test,
+                                  public terminal_read_test_base
+{
+protected:
+    // Reads the input, returning the tokens that were delivered, with the
+    // text of any pastes copied out of the terminal.
+    std::vector<terminalpp::token> read(terminalpp::bytes input)
+    {
+        std::vector<terminalpp::token> result;
+        terminal_.async_read([this, &result](terminalpp::tokens tokens) {
+            for (auto const &tok : tokens)
+            {
+                if (auto const *pst = std::get_if<terminalpp::paste>(&tok))
+                {
+                    pasted_.emplace_back(pst->text.begin(), pst->text.end());
+                }
+
+                result.push_back(tok);
+            }
+        });
+
+        channel_.receive(input);
+        return result;
+    }
+
+    std::vector<terminalpp::byte_storage> pasted_;
+};
+
+TEST_F(a_terminal_reading_pastes, reads_a_paste_as_a_single_token)
+{
+    auto const input = "a\x1B[200~pasted\r\ntext\x1B[201~b"_tb;
+    auto const result = read(input);
+
+    ASSERT_EQ(3U, result.size());
+    EXPECT_TRUE(std::holds_alternative<terminalpp::virtual_key>(result[0]));
+    EXPECT_TRUE(std::holds_alternative<terminalpp::paste>(result[1]));
+    EXPECT_TRUE(std::holds_alternative<terminalpp::virtual_key>(result[2]));
+
+    ASSERT_EQ(1U, pasted_.size());
+    EXPECT_EQ("pasted\r\ntext"_tb, pasted_[0]);
+}
+
+TEST_F(a_terminal_reading_pastes, refers_to_the_input_for_a_paste_within_it)
+{
+    auto const input = "\x1B[200~text\x1B[201~"_tb;
+
+    terminalpp::bytes text;
+    terminal_.async_read([&text](terminalpp::tokens tokens) {
+        ASSERT_EQ(1U, tokens.size());
+        text = std::get<terminalpp::paste>(tokens[0]).text;
+    });
+
+    channel_.receive(input);
+
+    ASSERT_EQ(4U, text.size());
+    EXPECT_EQ(input.data() + 6, text.data());
+}
+
+TEST_F(a_terminal_reading_pastes, reads_an_empty_paste)
+{
+    auto const result = read("\x1B[200~\x1B[201~"_tb);
+
+    ASSERT_EQ(1U, result.size());
+    ASSERT_EQ(1U, pasted_.size());
+    EXPECT_TRUE(pasted_[0].empty());
+}
+
+TEST_F(a_terminal_reading_pastes, reads_a_paste_that_spans_reads)
+{
+    EXPECT_EQ(1U, read("x\x1B[200~first "_tb).size());
+    EXPECT_TRUE(read("second "_tb).empty());
+
+    auto const result = read("third\x1B[201~y"_tb);
+
+    ASSERT_EQ(2U, result.size());
+    ASSERT_EQ(1U, pasted_.size());
+    EXPECT_EQ("first second third"_tb, pasted_[0]);
+}
+
+TEST_F(a_terminal_reading_pastes, reads_a_paste_whose_end_marker_spans_reads)
+{
+    EXPECT_TRUE(read("\x1B[200~text\x1B["_tb).empty());
+    EXPECT_TRUE(read("20"_tb).empty());
+
+    auto const result = read("1~z"_tb);
+
+    ASSERT_EQ(2U, result.size());
+    ASSERT_EQ(1U, pasted_.size());
+    EXPECT_EQ("text"_tb, pasted_[0]);
+}
+
+TEST_F(
+    a_terminal_reading_pastes,
+    keeps_a_spanning_paste_when_another_begins_in_the_same_read)
+{
+    EXPECT_TRUE(read("\x1B[200~first "_tb).empty());
+
+    auto const result = read("second\x1B[201~\x1B[200~next paste"_tb);
+
+    ASSERT_EQ(1U, result.size());
+    ASSERT_EQ(1U, pasted_.size());
+    EXPECT_EQ("first second"_tb, pasted_[0]);
+
+    EXPECT_EQ(1U, read("\x1B[201~"_tb).size());
+    ASSERT_EQ(2U, pasted_.size());
+    EXPECT_EQ("next paste"_tb, pasted_[1]);
+}
+
+TEST_F(a_terminal_reading_pastes, keeps_partial_end_markers_in_the_text)
+{
+    auto const result = read("\x1B[200~a\x1B[20b\x1B[201~"_tb);
+
+    ASSERT_EQ(1U, result.size());
+    ASSERT_EQ(1U, pasted_.size());
+    EXPECT_EQ("a\x1B[20b"_tb, pasted_[0]);
+}
+
+TEST(a_parser, reads_a_paste_one_byte_at_a_time)
+{
+    terminalpp::detail::parser parser;
+    std::vector<terminalpp::byte_storage> pasted;
+
+    for (auto const ch : "\x1B[200~te\x1Bxt\x1B[201~"_tb)
+    {
+        if (auto const result = parser(ch); result.has_value())
+        {
+            auto const &text = std::get<terminalpp::paste>(*result).text;
+            pasted.emplace_back(text.begin(), text.end());
+        }
+    }
+
+    ASSERT_EQ(1U, pasted.size());
+    EXPECT_EQ("te\x1Bxt"_tb, pasted[0]);
+}
+
+TEST(a_parser, keeps_the_arguments_of_a_well_known_key_as_unsplit_text)
+{
+    terminalpp::detail::parser parser;
+    std::vector<terminalpp::token> tokens;
+
+    parser.parse("\x1B[1;5A"_tb, std::back_inserter(tokens));
+
+    // The key and its modifiers are read from the numeric parameters, and
+    // the arguments are held only as the text that was received.
+    ASSERT_EQ(1U, tokens.size());
+    auto const &key = std::get<terminalpp::virtual_key>(tokens[0]);
+    EXPECT_EQ(terminalpp::vk::cursor_up, key.key);
+    EXPECT_EQ(terminalpp::vk_modifier::ctrl, key.modifiers);
+
+    auto const &arguments =
+        std::get<terminalpp::control_sequence>(key.sequence).arguments;
+    EXPECT_TRUE(std::ranges::equal("1;5"_tb, arguments.text()));
+    EXPECT_TRUE(std::ranges::equal("5"_tb, arguments[1]));
+}
+
+TEST(a_parser, does_not_allocate_once_its_output_has_grown)
+{
+    auto const input =
+        "a\x1B[A\x1B[1;5A\x1B[24~\x1B[15;2~\x1BOP\x1B[<0;12;34M\x1B[M !!"_tb;
+
+    terminalpp::detail::parser parser;
+    std::vector<terminalpp::token> tokens;
+    parser.parse(input, std::back_inserter(tokens));
+
+    tokens.clear();
+    auto const allocations_before = allocation_count;
+    parser.parse(input, std::back_inserter(tokens));
+
+    EXPECT_EQ(8U, tokens.size());
+    EXPECT_EQ(allocations_before, allocation_count);
+}
+
+TEST(tokens, fit_within_a_cache_line)
+{
+    EXPECT_LE(sizeof(terminalpp::token), 64U);
+}
+
+// Parses each of the inputs in turn, returning the text of each paste.  The
+// text is copied only once each input has been parsed, so that it must
+// remain valid until then.
+std::vector<terminalpp::byte_storage> parse_pastes(
+    terminalpp::detail::parser &parser,
+    std::initializer_list<terminalpp::bytes> inputs)
+{
+    std::vector<terminalpp::token> tokens;
+    std::vector<terminalpp::byte_storage> pasted;
+
+    for (auto const input : inputs)
+    {
+        tokens.clear();
+        parser.parse(input, std::back_inserter(tokens));
+
+        for (auto const &tok : tokens)
+        {
+            if (auto const *pst = std::get_if<terminalpp::paste>(&tok))
+            {
+                pasted.emplace_back(pst->text.begin(), pst->text.end());
+            }
+        }
+    }
+
+    return pasted;
+}
+
+TEST(a_parser, reports_the_text_of_an_unterminated_paste_when_it_is_full)
+{
+    terminalpp::detail::parser parser{8};
+
+    auto const pasted =
+        parse_pastes(parser, {"\x1B[200~abcde"_tb, "fghijk"_tb});
+
+    ASSERT_EQ(1U, pasted.size());
+    EXPECT_EQ("abcdefgh"_tb, pasted[0]);
+
+    auto const rest = parse_pastes(parser, {"l\x1B[201~"_tb});
+
+    ASSERT_EQ(1U, rest.size());
+    EXPECT_EQ("ijkl"_tb, rest[0]);
+}
+
+TEST(a_parser, bounds_the_buffer_of_a_paste_that_never_ends)
+{
+    terminalpp::detail::parser parser{8};
+
+    auto const pasted = parse_pastes(
+        parser,
+        {"\x1B[200~abcd"_tb, "efghijklmnop"_tb, "qrstuvwxyz"_tb});
+
+    ASSERT_EQ(3U, pasted.size());
+    EXPECT_EQ("abcdefgh"_tb, pasted[0]);
+    EXPECT_EQ("ijklmnop"_tb, pasted[1]);
+    EXPECT_EQ("qrstuvwx"_tb, pasted[2]);
+}
+
+TEST(a_parser, keeps_a_partial_end_marker_when_reporting_a_full_paste)
+{
+    terminalpp::detail::parser parser{8};
+
+    auto const pasted = parse_pastes(
+        parser, {"\x1B[200~abc"_tb, "def\x1B[2"_tb, "01~"_tb});
+
+    // The text was reported when the buffer filled, and so only the end of
+    // the paste remains, which is empty.
+    ASSERT_EQ(2U, pasted.size());
+    EXPECT_EQ("abcdef"_tb, pasted[0]);
+    EXPECT_TRUE(pasted[1].empty());
+}
+
+TEST(a_parser, keeps_a_paste_when_a_return_is_reparsed_in_the_same_read)
+{
+    terminalpp::detail::parser parser{8};
+
+    // The CR ends up being reparsed when the x arrives, which must not
+    // release the paste that was reported earlier in the same input.
+    auto const pasted = parse_pastes(
+        parser,
+        {"\x1B[200~abc"_tb, "def\x1B[201~\rx\x1B[200~ZZZZZZZZZZZZ"_tb});
+
+    ASSERT_EQ(2U, pasted.size());
+    EXPECT_EQ("abcdef"_tb, pasted[0]);
+    EXPECT_EQ("ZZZZZZZZ"_tb, pasted[1]);
+}
+
 }  // namespace
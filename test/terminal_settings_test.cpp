@@ -85,6 +85,152 @@ TEST_F(
     EXPECT_THAT(channel_.written_, ContainerEq("\x1B[?1003l"_tb));
 }
 
+namespace {
+
+class a_terminal_with_sgr_mouse_support : public a_terminal
+{
+public:
+    a_terminal_with_sgr_mouse_support()
+      : a_terminal([] {
+            terminalpp::behaviour beh;
+            beh.supports_all_mouse_motion_tracking = true;
+            beh.supports_sgr_mouse_encoding = true;
+            return beh;
+        }())
+    {
+    }
+};
+
+}  // namespace
+
+TEST_F(
+    a_terminal_with_sgr_mouse_support,
+    sends_only_mouse_tracking_when_enabling_the_normal_encoding)
+{
+    terminal_ << terminalpp::enable_mouse();
+    EXPECT_THAT(channel_.written_, ContainerEq("\x1B[?1003h"_tb));
+
+    channel_.written_.clear();
+    terminal_ << terminalpp::disable_mouse();
+    EXPECT_THAT(channel_.written_, ContainerEq("\x1B[?1003l"_tb));
+}
+
+TEST_F(
+    a_terminal_with_sgr_mouse_support,
+    sends_enable_sgr_encoding_when_enabling_the_sgr_encoding)
+{
+    terminal_ << terminalpp::enable_mouse(terminalpp::mouse::encoding::sgr);
+    EXPECT_THAT(channel_.written_, ContainerEq("\x1B[?1003h\x1B[?1006h"_tb));
+}
+
+TEST_F(
+    a_terminal_with_sgr_mouse_support,
+    sends_disable_sgr_encoding_when_disabling_mouse)
+{
+    terminal_ << terminalpp::enable_mouse(terminalpp::mouse::encoding::sgr);
+    channel_.written_.clear();
+
+    terminal_ << terminalpp::disable_mouse();
+    EXPECT_THAT(channel_.written_, ContainerEq("\x1B[?1003l\x1B[?1006l"_tb));
+
+    channel_.written_.clear();
+    terminal_ << terminalpp::disable_mouse();
+    EXPECT_THAT(channel_.written_, ContainerEq("\x1B[?1003l"_tb));
+}
+
+TEST_F(
+    a_terminal_with_sgr_mouse_support,
+    does_not_send_an_unsupported_pixel_encoding)
+{
+    terminal_ << terminalpp::enable_mouse(
+        terminalpp::mouse::encoding::sgr_pixels);
+    EXPECT_THAT(channel_.written_, ContainerEq("\x1B[?1003h"_tb));
+}
+
+TEST_F(
+    a_terminal_with_basic_mouse_support,
+    does_not_send_an_unsupported_sgr_encoding)
+{
+    terminal_ << terminalpp::enable_mouse(terminalpp::mouse::encoding::sgr);
+    EXPECT_THAT(channel_.written_, ContainerEq("\x1B[?1000h"_tb));
+}
+
+namespace {
+
+class a_terminal_with_sgr_pixel_mouse_support : public a_terminal
+{
+public:
+    a_terminal_with_sgr_pixel_mouse_support()
+      : a_terminal([] {
+            terminalpp::behaviour beh;
+            beh.supports_basic_mouse_tracking = true;
+            beh.supports_sgr_pixel_mouse_encoding = true;
+            return beh;
+        }())
+    {
+    }
+};
+
+}  // namespace
+
+TEST_F(
+    a_terminal_with_sgr_pixel_mouse_support,
+    sends_enable_pixel_encoding_when_enabling_the_pixel_encoding)
+{
+    terminal_ << terminalpp::enable_mouse(
+        terminalpp::mouse::encoding::sgr_pixels);
+    EXPECT_THAT(channel_.written_, ContainerEq("\x1B[?1000h\x1B[?1016h"_tb));
+
+    channel_.written_.clear();
+    terminal_ << terminalpp::disable_mouse();
+    EXPECT_THAT(channel_.written_, ContainerEq("\x1B[?1000l\x1B[?1016l"_tb));
+}
+
+TEST_F(a_terminal, enabling_bracketed_paste_sends_nothing)
+{
+    terminal_ << terminalpp::enable_bracketed_paste();
+    EXPECT_THAT(channel_.written_, ContainerEq(""_tb));
+}
+
+TEST_F(a_terminal, disabling_bracketed_paste_sends_nothing)
+{
+    terminal_ << terminalpp::disable_bracketed_paste();
+    EXPECT_THAT(channel_.written_, ContainerEq(""_tb));
+}
+
+namespace {
+
+class a_terminal_with_bracketed_paste_support : public a_terminal
+{
+public:
+    a_terminal_with_bracketed_paste_support()
+      : a_terminal([] {
+            terminalpp::behaviour beh;
+            beh.supports_bracketed_paste = true;
+            return beh;
+        }())
+    {
+    }
+};
+
+}  // namespace
+
+TEST_F(
+    a_terminal_with_bracketed_paste_support,
+    sends_enable_bracketed_paste_when_enabling_bracketed_paste)
+{
+    terminal_ << terminalpp::enable_bracketed_paste();
+    EXPECT_THAT(channel_.written_, ContainerEq("\x1B[?2004h"_tb));
+}
+
+TEST_F(
+    a_terminal_with_bracketed_paste_support,
+    sends_disable_bracketed_paste_when_disabling_bracketed_paste)
+{
+    terminal_ << terminalpp::disable_bracketed_paste();
+    EXPECT_THAT(channel_.written_, ContainerEq("\x1B[?2004l"_tb));
+}
+
 TEST_F(a_terminal, setting_window_title_sends_nothing)
 {
     terminal_ << terminalpp::set_window_title("title");
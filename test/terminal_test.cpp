@@ -1,7 +1,58 @@
 #include "terminal_test.hpp"
 
+#include <gmock/gmock.h>
+
+#include <array>
+#include <span>
+#include <vector>
+
+using namespace terminalpp::literals;  // NOLINT
+using testing::ContainerEq;
+using testing::ElementsAre;
+
 namespace {
 
+// A channel that also supports gathering writes, and records the number of
+// fragments in each.
+struct fake_gathering_channel : fake_channel
+{
+    using fake_channel::write;
+
+    void write(std::span<terminalpp::bytes const> fragments)
+    {
+        for (auto const fragment : fragments)
+        {
+            written_.append(fragment.begin(), fragment.end());
+        }
+
+        fragment_counts_.push_back(fragments.size());
+        ++write_count_;
+    }
+
+    std::vector<std::size_t> fragment_counts_;
+};
+
+// A manipulator that writes a large block of static data between ordinary
+// output.
+struct write_static_block
+{
+    static constexpr auto block = [] {
+        std::array<terminalpp::byte, 64> result{};
+        result.fill('x');
+        return result;
+    }();
+
+    void operator()(
+        terminalpp::behaviour const & /*beh*/,
+        terminalpp::terminal_state & /*state*/,
+        terminalpp::write_continuation write_fn) const
+    {
+        write_fn("<"_tb);
+        write_fn(terminalpp::static_bytes{block});
+        write_fn(">"_tb);
+    }
+};
+
 TEST_F(a_terminal, is_alive_if_its_underlying_channel_is_alive)
 {
     ASSERT_TRUE(terminal_.is_alive());
@@ -17,4 +68,275 @@ TEST_F(a_terminal, closes_its_underlying_channel_if_it_is_closed)
     ASSERT_FALSE(channel_.is_alive());
 }
 
+TEST_F(a_terminal, writes_the_output_of_a_manipulator_in_a_single_write)
+{
+    channel_.write_count_ = 0;
+
+    terminal_ << terminalpp::move_cursor({4, 7});
+
+    EXPECT_THAT(channel_.written_, ContainerEq("\x1B[8;5H"_tb));
+    EXPECT_EQ(1U, channel_.write_count_);
+}
+
+TEST_F(a_terminal, writes_the_output_of_a_manipulator_taking_a_std_function)
+{
+    struct write_abc
+    {
+        void operator()(
+            terminalpp::behaviour const & /*beh*/,
+            terminalpp::terminal_state & /*state*/,
+            terminalpp::terminal::write_function const &write_fn) const
+        {
+            write_fn("abc"_tb);
+        }
+    };
+
+    terminal_ << write_abc{};
+
+    EXPECT_THAT(channel_.written_, ContainerEq("abc"_tb));
+}
+
+TEST_F(a_terminal, writes_an_attributed_string_in_a_single_write)
+{
+    channel_.write_count_ = 0;
+
+    terminal_ << R"(\i>abc)"_ets;
+
+    EXPECT_THAT(channel_.written_, ContainerEq("\x1B[1mabc"_tb));
+    EXPECT_EQ(1U, channel_.write_count_);
+}
+
+TEST_F(a_terminal, with_a_flush_threshold_holds_output_until_flushed)
+{
+    terminal_.set_flush_threshold(1024);
+    channel_.write_count_ = 0;
+
+    terminal_ << terminalpp::move_cursor({4, 7}) << "abc"_ets;
+    terminal_.write("def"_tb);
+
+    EXPECT_TRUE(channel_.written_.empty());
+    EXPECT_EQ(0U, channel_.write_count_);
+
+    terminal_.flush();
+
+    EXPECT_THAT(channel_.written_, ContainerEq("\x1B[8;5Habcdef"_tb));
+    EXPECT_EQ(1U, channel_.write_count_);
+}
+
+TEST_F(a_terminal, with_a_flush_threshold_flushes_when_it_is_reached)
+{
+    terminal_.set_flush_threshold(4);
+    channel_.write_count_ = 0;
+
+    terminal_.write("abc"_tb);
+    EXPECT_EQ(0U, channel_.write_count_);
+
+    terminal_.write("def"_tb);
+    EXPECT_THAT(channel_.written_, ContainerEq("abcdef"_tb));
+    EXPECT_EQ(1U, channel_.write_count_);
+}
+
+TEST_F(a_terminal, flushes_buffered_output_when_the_threshold_is_lowered)
+{
+    terminal_.set_flush_threshold(1024);
+    terminal_.write("abc"_tb);
+    EXPECT_TRUE(channel_.written_.empty());
+
+    terminal_.set_flush_threshold(0);
+    EXPECT_THAT(channel_.written_, ContainerEq("abc"_tb));
+}
+
+TEST_F(a_terminal, flushing_an_empty_buffer_writes_nothing)
+{
+    channel_.write_count_ = 0;
+
+    terminal_.flush();
+
+    EXPECT_EQ(0U, channel_.write_count_);
+}
+
+TEST_F(a_terminal, writes_fragments_to_a_channel_in_a_single_write)
+{
+    channel_.write_count_ = 0;
+    std::array const storage = {"\x1B["_tb, "8;5"_tb, "H"_tb};
+    std::vector<terminalpp::bytes> const fragments(
+        storage.begin(), storage.end());
+
+    terminal_.write(fragments);
+
+    EXPECT_THAT(channel_.written_, ContainerEq("\x1B[8;5H"_tb));
+    EXPECT_EQ(1U, channel_.write_count_);
+}
+
+TEST_F(a_terminal, with_a_flush_threshold_holds_fragments_until_flushed)
+{
+    terminal_.set_flush_threshold(1024);
+    channel_.write_count_ = 0;
+    std::array const storage = {"abc"_tb, "def"_tb};
+    std::vector<terminalpp::bytes> const fragments(
+        storage.begin(), storage.end());
+
+    terminal_.write(fragments);
+    EXPECT_EQ(0U, channel_.write_count_);
+
+    terminal_.flush();
+    EXPECT_THAT(channel_.written_, ContainerEq("abcdef"_tb));
+    EXPECT_EQ(1U, channel_.write_count_);
+}
+
+TEST(a_terminal_with_a_gathering_channel, passes_fragments_to_the_channel)
+{
+    fake_gathering_channel channel;
+    terminalpp::terminal terminal{channel};
+    std::array const storage = {"\x1B["_tb, "8;5"_tb, "H"_tb};
+    std::vector<terminalpp::bytes> const fragments(
+        storage.begin(), storage.end());
+
+    terminal.write(fragments);
+
+    EXPECT_THAT(channel.written_, ContainerEq("\x1B[8;5H"_tb));
+    EXPECT_THAT(channel.fragment_counts_, ElementsAre(3U));
+}
+
+TEST(
+    a_terminal_with_a_gathering_channel,
+    sends_buffered_output_ahead_of_fragments)
+{
+    fake_gathering_channel channel;
+    terminalpp::terminal terminal{channel};
+    terminal.set_flush_threshold(4);
+
+    terminal.write("ab"_tb);
+    EXPECT_TRUE(channel.fragment_counts_.empty());
+
+    std::array const storage = {"cd"_tb, ""_tb, "ef"_tb};
+    std::vector<terminalpp::bytes> const fragments(
+        storage.begin(), storage.end());
+    terminal.write(fragments);
+
+    EXPECT_THAT(channel.written_, ContainerEq("abcdef"_tb));
+    EXPECT_THAT(channel.fragment_counts_, ElementsAre(3U));
+}
+
+TEST(
+    a_terminal_with_a_gathering_channel,
+    copies_short_constant_sequences)
+{
+    fake_gathering_channel channel;
+    terminalpp::terminal terminal{channel};
+
+    terminal << terminalpp::move_cursor({4, 7});
+
+    // Describing the CSI and the command as fragments of their own would
+    // cost more than copying them, so the sequence is sent as one block.
+    EXPECT_THAT(channel.written_, ContainerEq("\x1B[8;5H"_tb));
+    EXPECT_TRUE(channel.fragment_counts_.empty());
+    EXPECT_EQ(1U, channel.write_count_);
+}
+
+TEST(
+    a_terminal_with_a_gathering_channel,
+    sends_large_static_blocks_without_copying_them)
+{
+    fake_gathering_channel channel;
+    terminalpp::terminal terminal{channel};
+
+    terminal << write_static_block{};
+
+    auto const &block = write_static_block::block;
+    auto expected = "<"_tb;
+    expected.append(block.begin(), block.end());
+    expected.append(">"_tb);
+
+    // The block is sent either side of the buffered output.
+    EXPECT_THAT(channel.written_, ContainerEq(expected));
+    EXPECT_THAT(channel.fragment_counts_, ElementsAre(3U));
+}
+
+TEST(
+    a_terminal_with_a_gathering_channel,
+    copies_static_blocks_beyond_a_limit)
+{
+    fake_channel reference_channel;
+    terminalpp::terminal reference_terminal{reference_channel};
+    fake_gathering_channel channel;
+    terminalpp::terminal terminal{channel};
+    terminal.set_flush_threshold(8192);
+    reference_terminal.set_flush_threshold(8192);
+
+    for (int index = 0; index < 64; ++index)
+    {
+        terminal << write_static_block{};
+        reference_terminal << write_static_block{};
+    }
+
+    terminal.flush();
+    reference_terminal.flush();
+
+    EXPECT_THAT(channel.written_, ContainerEq(reference_channel.written_));
+    ASSERT_EQ(1U, channel.fragment_counts_.size());
+    EXPECT_LE(channel.fragment_counts_.front(), 33U);
+}
+
+TEST(a_terminal_of_a_known_channel_type, writes_directly_to_the_channel)
+{
+    fake_channel channel;
+    terminalpp::basic_terminal<fake_channel> terminal{channel};
+
+    terminal << terminalpp::move_cursor({4, 7});
+
+    EXPECT_THAT(channel.written_, ContainerEq("\x1B[8;5H"_tb));
+    EXPECT_EQ(1U, channel.write_count_);
+}
+
+TEST(a_terminal_of_a_known_channel_type, reads_tokens_from_the_channel)
+{
+    fake_channel channel;
+    terminalpp::basic_terminal<fake_channel> terminal{channel};
+
+    terminalpp::token_storage result;
+    terminal.async_read([&result](terminalpp::tokens tokens) {
+        result.assign(tokens.begin(), tokens.end());
+    });
+
+    channel.receive("z"_tb);
+
+    terminalpp::token const expected = terminalpp::virtual_key{
+        .key = terminalpp::vk::lowercase_z,
+        .modifiers = terminalpp::vk_modifier::none,
+        .repeat_count = 1,
+        .sequence = {'z'_tb}};
+    EXPECT_THAT(result, ElementsAre(expected));
+}
+
+TEST(a_terminal_of_a_known_channel_type, reports_the_state_of_the_channel)
+{
+    fake_channel channel;
+    terminalpp::basic_terminal<fake_channel> terminal{channel};
+
+    EXPECT_FALSE(terminal.is_backpressured());
+    channel.backpressured_ = true;
+    EXPECT_TRUE(terminal.is_backpressured());
+
+    terminal.close();
+    EXPECT_FALSE(terminal.is_alive());
+}
+
+TEST(a_terminal_of_a_known_channel_type, passes_fragments_to_the_channel)
+{
+    fake_gathering_channel channel;
+    terminalpp::basic_terminal<fake_gathering_channel> terminal{channel};
+    terminal.set_flush_threshold(4);
+
+    terminal.write("ab"_tb);
+
+    std::array const storage = {"cd"_tb, "ef"_tb};
+    std::vector<terminalpp::bytes> const fragments(
+        storage.begin(), storage.end());
+    terminal.write(fragments);
+
+    EXPECT_THAT(channel.written_, ContainerEq("abcdef"_tb));
+    EXPECT_THAT(channel.fragment_counts_, ElementsAre(3U));
+}
+
 }  // namespace
@@ -0,0 +1,206 @@
+#include "terminalpp/detail/token_coalescing.hpp"
+
+#include <gtest/gtest.h>
+
+#include <limits>
+
+using namespace terminalpp::literals;  // NOLINT
+
+namespace {
+
+terminalpp::token motion(
+    terminalpp::coordinate_type x,
+    terminalpp::mouse::button button = terminalpp::mouse::button::none)
+{
+    return terminalpp::mouse::event{
+        .action_ = terminalpp::mouse::event_type::no_button_change,
+        .position_ = {x, 0},
+        .button_ = button};
+}
+
+terminalpp::token const click = terminalpp::mouse::event{
+    .action_ = terminalpp::mouse::event_type::left_button_down,
+    .position_ = {0, 0},
+    .button_ = terminalpp::mouse::button::left};
+
+terminalpp::token const key = terminalpp::virtual_key{
+    .key = terminalpp::vk::lowercase_x, .repeat_count = 1, .sequence = 'x'_tb};
+
+TEST(coalescing_mouse_motion, leaves_an_empty_sequence_empty)
+{
+    terminalpp::token_storage tokens;
+    terminalpp::detail::coalesce_mouse_motion(tokens);
+
+    ASSERT_TRUE(tokens.empty());
+}
+
+TEST(coalescing_mouse_motion, keeps_the_last_of_a_run_of_motion_events)
+{
+    terminalpp::token_storage tokens{motion(0), motion(1), motion(2)};
+    terminalpp::detail::coalesce_mouse_motion(tokens);
+
+    ASSERT_EQ(terminalpp::token_storage{motion(2)}, tokens);
+}
+
+TEST(coalescing_mouse_motion, does_not_merge_motion_across_other_tokens)
+{
+    terminalpp::token_storage tokens{
+        motion(0), motion(1), key, motion(2), click, motion(3), motion(4)};
+    terminalpp::detail::coalesce_mouse_motion(tokens);
+
+    terminalpp::token_storage const expected{
+        motion(1), key, motion(2), click, motion(4)};
+    ASSERT_EQ(expected, tokens);
+}
+
+TEST(coalescing_mouse_motion, does_not_merge_motion_with_different_buttons)
+{
+    auto const left = terminalpp::mouse::button::left;
+
+    terminalpp::token_storage tokens{
+        motion(0), motion(1, left), motion(2, left), motion(3)};
+    terminalpp::detail::coalesce_mouse_motion(tokens);
+
+    terminalpp::token_storage const expected{
+        motion(0), motion(2, left), motion(3)};
+    ASSERT_EQ(expected, tokens);
+}
+
+TEST(coalescing_key_repeats, leaves_an_empty_sequence_empty)
+{
+    terminalpp::token_storage tokens;
+    terminalpp::detail::coalesce_key_repeats(tokens);
+
+    ASSERT_TRUE(tokens.empty());
+}
+
+TEST(coalescing_key_repeats, sums_the_repeat_counts_of_identical_keys)
+{
+    terminalpp::token_storage tokens{key, key, key};
+    terminalpp::detail::coalesce_key_repeats(tokens);
+
+    terminalpp::token const expected = terminalpp::virtual_key{
+        .key = terminalpp::vk::lowercase_x,
+        .repeat_count = 3,
+        .sequence = 'x'_tb};
+    ASSERT_EQ(terminalpp::token_storage{expected}, tokens);
+}
+
+TEST(coalescing_key_repeats, does_not_merge_different_keys)
+{
+    terminalpp::token const shifted = terminalpp::virtual_key{
+        .key = terminalpp::vk::lowercase_x,
+        .modifiers = terminalpp::vk_modifier::shift,
+        .repeat_count = 1,
+        .sequence = 'x'_tb};
+    terminalpp::token const other = terminalpp::virtual_key{
+        .key = terminalpp::vk::lowercase_y,
+        .repeat_count = 1,
+        .sequence = 'y'_tb};
+
+    terminalpp::token_storage tokens{key, shifted, other, key};
+    terminalpp::detail::coalesce_key_repeats(tokens);
+
+    terminalpp::token_storage const expected{key, shifted, other, key};
+    ASSERT_EQ(expected, tokens);
+}
+
+TEST(coalescing_key_repeats, does_not_merge_keys_across_other_tokens)
+{
+    terminalpp::token_storage tokens{key, motion(0), key, click, key};
+    terminalpp::detail::coalesce_key_repeats(tokens);
+
+    terminalpp::token_storage const expected{key, motion(0), key, click, key};
+    ASSERT_EQ(expected, tokens);
+}
+
+TEST(coalescing_key_repeats, adds_existing_repeat_counts)
+{
+    terminalpp::token const cursor_up = terminalpp::virtual_key{
+        .key = terminalpp::vk::cursor_up,
+        .repeat_count = 2,
+        .sequence = terminalpp::control_sequence{
+            .initiator = '[', .command = 'A', .arguments = {"2"_tb}}};
+
+    terminalpp::token_storage tokens{cursor_up, cursor_up};
+    terminalpp::detail::coalesce_key_repeats(tokens);
+
+    ASSERT_EQ(1U, tokens.size());
+    EXPECT_EQ(4, std::get<terminalpp::virtual_key>(tokens[0]).repeat_count);
+}
+
+TEST(coalescing_key_repeats, does_not_merge_keys_whose_count_would_overflow)
+{
+    auto const max_count = (std::numeric_limits<int>::max)();
+
+    terminalpp::token const cursor_up = terminalpp::virtual_key{
+        .key = terminalpp::vk::cursor_up,
+        .repeat_count = max_count,
+        .sequence = terminalpp::control_sequence{
+            .initiator = '[', .command = 'A', .arguments = {"2147483647"_tb}}};
+
+    terminalpp::token_storage tokens{cursor_up, cursor_up};
+    terminalpp::detail::coalesce_key_repeats(tokens);
+
+    ASSERT_EQ(2U, tokens.size());
+    EXPECT_EQ(
+        max_count, std::get<terminalpp::virtual_key>(tokens[0]).repeat_count);
+    EXPECT_EQ(
+        max_count, std::get<terminalpp::virtual_key>(tokens[1]).repeat_count);
+}
+
+TEST(merging_into_a_batch, does_not_merge_into_an_empty_batch)
+{
+    terminalpp::token_batch batch;
+
+    EXPECT_FALSE(terminalpp::detail::merge_into_last(batch, key, true, true));
+}
+
+TEST(merging_into_a_batch, merges_motion_when_enabled)
+{
+    terminalpp::token_batch batch;
+    batch.push_back(motion(0));
+
+    EXPECT_FALSE(
+        terminalpp::detail::merge_into_last(batch, motion(1), false, true));
+    EXPECT_TRUE(
+        terminalpp::detail::merge_into_last(batch, motion(1), true, false));
+
+    ASSERT_EQ(1U, batch.size());
+    EXPECT_EQ(motion(1), batch.expand(batch.back()));
+}
+
+TEST(merging_into_a_batch, merges_key_repeats_when_enabled)
+{
+    terminalpp::token_batch batch;
+    batch.push_back(terminalpp::token{key});
+
+    EXPECT_FALSE(terminalpp::detail::merge_into_last(batch, key, true, false));
+    EXPECT_TRUE(terminalpp::detail::merge_into_last(batch, key, false, true));
+
+    ASSERT_EQ(1U, batch.size());
+    EXPECT_EQ(
+        2,
+        std::get<terminalpp::compact_virtual_key>(batch.back()).repeat_count);
+}
+
+TEST(merging_into_a_batch, compares_the_control_sequences_of_keys)
+{
+    auto const cursor_up = [](terminalpp::byte_storage argument) {
+        return terminalpp::token{terminalpp::virtual_key{
+            .key = terminalpp::vk::cursor_up,
+            .repeat_count = 1,
+            .sequence = terminalpp::control_sequence{
+                .initiator = '[', .command = 'A', .arguments = {argument}}}};
+    };
+
+    terminalpp::token_batch batch;
+    batch.push_back(cursor_up("1"_tb));
+
+    EXPECT_FALSE(terminalpp::detail::merge_into_last(
+        batch, cursor_up("2"_tb), false, true));
+    EXPECT_TRUE(terminalpp::detail::merge_into_last(
+        batch, cursor_up("1"_tb), false, true));
+}
+
+}  // namespace
@@ -0,0 +1,60 @@
+#include <terminalpp/write_continuation.hpp>
+
+#include <gmock/gmock.h>
+
+#include <functional>
+#include <cstddef>
+
+using namespace terminalpp::literals;  // NOLINT
+using testing::ContainerEq;
+
+namespace {
+
+TEST(a_write_continuation, calls_the_function_to_which_it_refers)
+{
+    terminalpp::byte_storage result;
+    auto const append = [&result](terminalpp::bytes data) {
+        result.append(data.begin(), data.end());
+    };
+
+    terminalpp::write_continuation const write_fn{append};
+    write_fn("abc"_tb);
+    write_fn("def"_tb);
+
+    EXPECT_THAT(result, ContainerEq("abcdef"_tb));
+}
+
+TEST(a_write_continuation, refers_to_a_function_with_mutable_state)
+{
+    struct counter
+    {
+        void operator()(terminalpp::bytes data)
+        {
+            count_ += data.size();
+        }
+
+        std::size_t count_{0};
+    };
+
+    counter fn;
+    terminalpp::write_continuation const write_fn{fn};
+    write_fn("abc"_tb);
+
+    EXPECT_EQ(3U, fn.count_);
+}
+
+TEST(a_write_continuation, may_refer_to_a_std_function)
+{
+    terminalpp::byte_storage result;
+    std::function<void(terminalpp::bytes)> const append =
+        [&result](terminalpp::bytes data) {
+            result.append(data.begin(), data.end());
+        };
+
+    terminalpp::write_continuation const write_fn{append};
+    write_fn("abc"_tb);
+
+    EXPECT_THAT(result, ContainerEq("abc"_tb));
+}
+
+}  // namespace